@@ -0,0 +1,16 @@
+#!/bin/bash
+# Runs the benchmarks with each engine.
+# Usage: bench/run.sh [path/to/whiskey]
+
+WHISKEY=${1:-./whiskey}
+DIR=$(dirname "$0")
+TIMEFORMAT=%R
+
+printf '%-20s %10s %10s %10s\n' benchmark ast bytecode jit
+for file in "$DIR"/*.wsky; do
+    ast=$( { time "$WHISKEY" "$file" > /dev/null; } 2>&1 )
+    bytecode=$( { time "$WHISKEY" --bytecode "$file" > /dev/null; } 2>&1 )
+    jit=$( { time "$WHISKEY" --jit "$file" > /dev/null; } 2>&1 )
+    printf '%-20s %10s %10s %10s\n' "$(basename "$file" .wsky)" \
+           "$ast" "$bytecode" "$jit"
+done
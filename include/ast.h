@@ -1,9 +1,12 @@
 #ifndef AST_H_
 # define AST_H_
 
+# include "gc.h"
 # include "position.h"
 # include "token.h"
 # include "method_def.h"
+# include "scope_layout.h"
+# include "shape.h"
 
 /**
  * @defgroup ast ast
@@ -64,6 +67,10 @@ typedef enum {
 
   wsky_ASTNodeType_IF,
 
+  wsky_ASTNodeType_WHILE,
+
+  wsky_ASTNodeType_FOR,
+
 } wsky_ASTNodeType;
 
 
@@ -141,11 +148,36 @@ typedef struct {
     bool boolValue;
   } v;
 
+  /**
+   * If type == STRING, the String returned by
+   * wsky_LiteralNode_getString(), or an empty root
+   */
+  wsky_GCRoot stringObject;
+
 } wsky_LiteralNode;
 
 /** Creates a new wsky_LiteralNode */
 wsky_LiteralNode *wsky_LiteralNode_new(const wsky_Token *token);
 
+/**
+ * Creates a new wsky_LiteralNode from a null, a boolean, an integer, a
+ * float or a String.
+ *
+ * Returns NULL for the other values.
+ */
+wsky_LiteralNode *wsky_LiteralNode_newFromValue(wsky_Position position,
+                                                wsky_Value value);
+
+/**
+ * Returns the String of a string literal node.
+ *
+ * It is created on the first call, and then shared by all the
+ * evaluations of the node, since the Strings are immutable. The node
+ * keeps it alive with a root of the garbage collector.
+ */
+struct wsky_String_s *wsky_LiteralNode_getString(
+  const wsky_LiteralNode *node);
+
 
 /**
  * An identifier node
@@ -155,6 +187,9 @@ typedef struct {
 
   /** The identifier or NULL */
   char *name;
+
+  /** The lexical address of the variable, if type == IDENTIFIER */
+  wsky_LexicalAddress address;
 } wsky_IdentifierNode;
 
 /** Creates a new wsky_IdentifierNode from a wsky_Token */
@@ -197,6 +232,43 @@ wsky_TpltPrintNode *wsky_TpltPrintNode_new(const wsky_Token *token,
                                            wsky_ASTNode *child);
 
 
+/**
+ * The operand types a binary operator node is specialized for
+ */
+typedef enum {
+  /** Any types, or mixed types when observed */
+  wsky_OperandTypes_GENERIC,
+
+  wsky_OperandTypes_INT,
+  wsky_OperandTypes_FLOAT,
+  wsky_OperandTypes_STRING,
+} wsky_OperandTypes;
+
+/**
+ * The types observed by a binary operator node, used by the evaluator
+ * to specialize the node
+ */
+typedef struct {
+  /** The types the node is specialized for */
+  wsky_OperandTypes specialization;
+
+  /** The types of the last generic executions */
+  wsky_OperandTypes observed;
+
+  /** The number of generic executions in a row with these types */
+  unsigned observedCount;
+
+  /** The number of executions of the specialized code */
+  unsigned hits;
+
+  /** The number of guard misses, each one despecializes the node */
+  unsigned misses;
+} wsky_TypeFeedback;
+
+# define wsky_TypeFeedback_EMPTY                                        \
+  ((wsky_TypeFeedback) {wsky_OperandTypes_GENERIC,                      \
+      wsky_OperandTypes_GENERIC, 0, 0, 0})
+
 /**
  * An operator node
  */
@@ -212,6 +284,9 @@ typedef struct {
   /** The right node */
   wsky_ASTNode *right;
 
+  /** The type feedback of a binary operator */
+  wsky_TypeFeedback feedback;
+
 } wsky_OperatorNode;
 
 /** Creates a binary operator */
@@ -309,6 +384,9 @@ typedef struct {
 
   /** `true` if this node is the root of a program. */
   bool program;
+
+  /** The variables of the scope of the sequence, or NULL if unresolved */
+  wsky_ScopeLayout *layout;
 } wsky_SequenceNode;
 
 
@@ -327,9 +405,27 @@ typedef struct {
   /** A list of the parameters */
   wsky_ASTNodeList *parameters;
 
+  /** The length of the list of the parameters */
+  unsigned parameterCount;
+
   /** The name or NULL */
   char *name;
 
+  /**
+   * The variables of the scope of a call, starting with the parameters,
+   * or NULL if unresolved
+   */
+  wsky_ScopeLayout *layout;
+
+  /** The compiled body, or NULL if not compiled yet */
+  struct wsky_Code_s *code;
+
+  /**
+   * The number of owners of the node: its parent node and the
+   * functions created from it
+   */
+  unsigned referenceCount;
+
 } wsky_FunctionNode;
 
 /** Creates a function node */
@@ -339,6 +435,12 @@ wsky_FunctionNode *wsky_FunctionNode_new(const wsky_Token *token,
 
 void wsky_FunctionNode_setName(wsky_FunctionNode *node, const char *newName);
 
+/**
+ * Increments the reference count and returns the node.
+ * The node is deleted by wsky_ASTNode_delete() when the count reaches 0.
+ */
+wsky_FunctionNode *wsky_FunctionNode_retain(const wsky_FunctionNode *node);
+
 
 /**
  * A variable declaration node
@@ -352,6 +454,9 @@ typedef struct {
   /** The right node (the value to assign to the variable) or NULL */
   wsky_ASTNode *right;
 
+  /** The lexical address of the variable */
+  wsky_LexicalAddress address;
+
 } wsky_VarNode;
 
 wsky_VarNode *wsky_VarNode_new(const wsky_Token *token,
@@ -387,6 +492,15 @@ typedef struct {
   /** The node of the function to call */
   wsky_ASTNode *left;
 
+  /** The length of the list of the parameters */
+  unsigned parameterCount;
+
+  /**
+   * True if the call is the last thing done by its function, set by
+   * the resolver
+   */
+  bool tailCall;
+
 } wsky_CallNode;
 
 wsky_CallNode *wsky_CallNode_new(const wsky_Token *token,
@@ -406,6 +520,18 @@ typedef struct {
   /** The member name */
   char *name;
 
+  /** The selector of the name, set by the resolver, or -1 */
+  int selector;
+
+  /**
+   * The slot of the field in the layout of the class, for `@name`, or
+   * -1
+   */
+  int fieldSlot;
+
+  /** The slot of the member in the last Structure read by the node */
+  wsky_ShapeCache shapeCache;
+
 } wsky_MemberAccessNode;
 
 wsky_MemberAccessNode *wsky_MemberAccessNode_new(const wsky_Token *token,
@@ -426,6 +552,12 @@ typedef struct {
   /** The implemented interfaces */
   wsky_ASTNodeList *interfaces;
 
+  /**
+   * The names of the private fields of the class, or NULL if
+   * unresolved
+   */
+  wsky_ScopeLayout *fields;
+
 } wsky_ClassNode;
 
 wsky_ClassNode *wsky_ClassNode_new(const wsky_Token *token,
@@ -515,6 +647,59 @@ wsky_IfNode *wsky_IfNode_new(wsky_Position position,
                              wsky_ASTNodeList *expressions,
                              wsky_ASTNode *elseNode);
 
+
+
+# define wsky_LoopNode_HEAD                                             \
+  wsky_ASTNode_HEAD                                                     \
+                                                                        \
+  /**                                                                   \
+   * The body. If it is a sequence, its children are evaluated in the  \
+   * scope of the loop, and the sequence creates no scope.             \
+   */                                                                   \
+  wsky_ASTNode *body;                                                   \
+                                                                        \
+  /**                                                                   \
+   * The variables of the scope of the loop, or NULL if unresolved.     \
+   * The scope is created once per loop, and its variables are          \
+   * undeclared before each iteration.                                  \
+   */                                                                   \
+  wsky_ScopeLayout *layout;
+
+/** A `while` or a `for` loop */
+typedef struct {
+  wsky_LoopNode_HEAD
+} wsky_LoopNode;
+
+
+/** A `while` loop */
+typedef struct {
+  wsky_LoopNode_HEAD
+
+  /** The test, evaluated in the scope of the loop */
+  wsky_ASTNode *test;
+} wsky_WhileNode;
+
+wsky_WhileNode *wsky_WhileNode_new(wsky_Position position,
+                                   wsky_ASTNode *test,
+                                   wsky_ASTNode *body);
+
+
+/** A `for ... in` loop */
+typedef struct {
+  wsky_LoopNode_HEAD
+
+  /** The name of the loop variable, the slot 0 of the layout */
+  char *name;
+
+  /** The iterated value, evaluated once before the loop */
+  wsky_ASTNode *iterable;
+} wsky_ForNode;
+
+wsky_ForNode *wsky_ForNode_new(wsky_Position position,
+                               const char *name,
+                               wsky_ASTNode *iterable,
+                               wsky_ASTNode *body);
+
 /**
  * @}
  */
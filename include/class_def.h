@@ -53,6 +53,15 @@ typedef struct {
 /** Returns a pointer to a list of the builtin classes */
 const wsky_ClassArray *wsky_getBuiltinClasses(void);
 
+/**
+ * Returns the builtin global variable of the given name, or NULL.
+ *
+ * The builtins are shared by all the root scopes. They are stored in a
+ * perfect hash table built by wsky_initBuiltinClasses(), so a lookup
+ * costs one hash and at most one string comparison.
+ */
+const wsky_Value *wsky_getBuiltin(const char *name);
+
 void wsky_initBuiltinClasses(void);
 void wsky_freeBuiltinClasses(void);
 
@@ -0,0 +1,220 @@
+#ifndef CODE_H_
+# define CODE_H_
+
+# include "ast.h"
+# include "value.h"
+
+/**
+ * @defgroup Code Code
+ * The bytecode of the virtual machine.
+ * @{
+ */
+
+/**
+ * The instructions of the virtual machine.
+ *
+ * Each instruction is followed by an operand, which is ignored by the
+ * instructions which don't need one.
+ */
+typedef enum {
+  /** Pushes `null` */
+  wsky_Opcode_PUSH_NULL,
+
+  /** Pushes `true` */
+  wsky_Opcode_PUSH_TRUE,
+
+  /** Pushes `false` */
+  wsky_Opcode_PUSH_FALSE,
+
+  /** Pushes the constant of the given index */
+  wsky_Opcode_PUSH_CONSTANT,
+
+  /** Pushes the String of the literal node of the given index */
+  wsky_Opcode_PUSH_STRING,
+
+  /** Pushes the value of the identifier node of the given index */
+  wsky_Opcode_LOAD_VARIABLE,
+
+  /**
+   * Declares the variable of the var node of the given index, with
+   * the value on the top of the stack
+   */
+  wsky_Opcode_DECLARE_VARIABLE,
+
+  /**
+   * Assigns the value on the top of the stack to the variable of the
+   * identifier node of the given index
+   */
+  wsky_Opcode_STORE_VARIABLE,
+
+  /** Removes the value on the top of the stack */
+  wsky_Opcode_POP,
+
+  /**
+   * Applies the operator of the operator node of the given index to
+   * the two values on the top
+   */
+  wsky_Opcode_BINARY_OPERATOR,
+
+  /** Applies the given operator to the value on the top */
+  wsky_Opcode_UNARY_OPERATOR,
+
+  /**
+   * Calls the value below the given number of parameters, and
+   * replaces them with the result
+   */
+  wsky_Opcode_CALL,
+
+  /** Like CALL, but with wsky_Function_tailCall() */
+  wsky_Opcode_TAIL_CALL,
+
+  /**
+   * Replaces the object on the top with the method called by the
+   * member access node of the given index, and pushes the object again.
+   * If the member is not a method, it is read as with GET_MEMBER.
+   */
+  wsky_Opcode_GET_METHOD,
+
+  /**
+   * Calls the method or the value pushed by GET_METHOD with the given
+   * number of parameters, and replaces them with the result
+   */
+  wsky_Opcode_CALL_METHOD,
+
+  /** Like CALL_METHOD, but with wsky_Method_tailCall() */
+  wsky_Opcode_TAIL_CALL_METHOD,
+
+  /**
+   * Replaces the value on the top with its member whose name is the
+   * name of the member access node of the given index
+   */
+  wsky_Opcode_GET_MEMBER,
+
+  /**
+   * Pops an object and sets its member whose name is the name of the
+   * member access node of the given index, with the value on the top
+   */
+  wsky_Opcode_SET_MEMBER,
+
+  /** Pushes a new Function from the function node of the given index */
+  wsky_Opcode_MAKE_FUNCTION,
+
+  /** Jumps to the given instruction */
+  wsky_Opcode_JUMP,
+
+  /** Pops a boolean and jumps to the given instruction if it is false */
+  wsky_Opcode_JUMP_IF_FALSE,
+
+  /**
+   * Creates the scope of the sequence node of the given index, and makes
+   * it the current scope
+   */
+  wsky_Opcode_ENTER_SCOPE,
+
+  /** Goes back to the parent of the current scope */
+  wsky_Opcode_LEAVE_SCOPE,
+
+  /**
+   * Creates the scope of the loop node of the given index, and makes it
+   * the current scope. LEAVE_SCOPE leaves it.
+   */
+  wsky_Opcode_ENTER_LOOP,
+
+  /** Prepares the current loop scope for the next iteration */
+  wsky_Opcode_NEXT_ITERATION,
+
+  /**
+   * Replaces the iterable value on the top with an iterator, which
+   * takes two values on the stack
+   */
+  wsky_Opcode_ITERATE,
+
+  /**
+   * Advances the iterator below the top. Pushes `true` and declares the
+   * loop variable with the next element, or pushes `false` at the end
+   */
+  wsky_Opcode_FOR_NEXT,
+
+  /**
+   * Evaluates the node of the given index with wsky_evalNode(), for the
+   * nodes which are not compiled
+   */
+  wsky_Opcode_EVAL_NODE,
+
+  /** Stops the execution and returns the value on the top */
+  wsky_Opcode_RETURN,
+} wsky_Opcode;
+
+/** Returns the name of an opcode */
+const char *wsky_Opcode_toString(wsky_Opcode opcode);
+
+
+
+/**
+ * A compiled node.
+ *
+ * The code does not own the nodes it refers to. They must live longer
+ * than the code.
+ */
+typedef struct wsky_Code_s {
+  /** The instructions and their operands */
+  int *instructions;
+
+  /** The number of ints in `instructions` */
+  unsigned instructionCount;
+
+  /** The allocated length of `instructions` */
+  unsigned instructionCapacity;
+
+  /** The integers and the floats of the literal nodes */
+  wsky_Value *constants;
+
+  unsigned constantCount;
+
+  unsigned constantCapacity;
+
+  /** The nodes referred to by the instructions */
+  const wsky_ASTNode **nodes;
+
+  unsigned nodeCount;
+
+  unsigned nodeCapacity;
+
+  /** The maximum number of values on the stack */
+  unsigned maxStackSize;
+
+  /** The number of runs, to find the hot code for the JIT compiler */
+  unsigned runCount;
+
+  /** The machine code generated by wsky_jit_compile(), or NULL */
+  void *machineCode;
+
+  /** The size of the memory mapped for `machineCode` */
+  size_t machineCodeSize;
+} wsky_Code;
+
+
+/** Returns a new empty code */
+wsky_Code *wsky_Code_new(void);
+
+/** Deletes a code */
+void wsky_Code_delete(wsky_Code *code);
+
+/** Appends an instruction and returns its index */
+unsigned wsky_Code_addInstruction(wsky_Code *code,
+                                  wsky_Opcode opcode, int operand);
+
+/** Adds a constant and returns its index */
+int wsky_Code_addConstant(wsky_Code *code, wsky_Value value);
+
+/** Adds a node and returns its index */
+int wsky_Code_addNode(wsky_Code *code, const wsky_ASTNode *node);
+
+/** Prints the instructions, for debugging */
+void wsky_Code_print(const wsky_Code *code, FILE *output);
+
+/**
+ * @}
+ */
+
+#endif /* !CODE_H_ */
@@ -0,0 +1,39 @@
+#ifndef COMPILER_H_
+# define COMPILER_H_
+
+# include "code.h"
+
+/**
+ * @defgroup compiler compiler
+ * Compiles the resolved nodes to bytecode.
+ *
+ * The nodes which have no instruction yet (the classes, the imports...)
+ * are compiled to an EVAL_NODE instruction, so that any node can be
+ * compiled.
+ *
+ * @{
+ */
+
+/**
+ * Compiles a node which will be run in the given scope, like
+ * wsky_evalNode() does.
+ */
+wsky_Code *wsky_compile(const wsky_ASTNode *node);
+
+/**
+ * Compiles the children of a sequence without creating a scope, like
+ * wsky_evalSequence() does.
+ */
+wsky_Code *wsky_compileSequence(const wsky_SequenceNode *node);
+
+/**
+ * Compiles the body of a function. The scope of the call is created by
+ * the caller.
+ */
+wsky_Code *wsky_compileFunction(const wsky_FunctionNode *node);
+
+/**
+ * @}
+ */
+
+#endif /* !COMPILER_H_ */
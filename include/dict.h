@@ -63,6 +63,15 @@ void wsky_Dict_apply(wsky_Dict *self,
 void wsky_Dict_applyConst(const wsky_Dict *self,
                           void (*function)(const char *key, void *value));
 
+/**
+ * Applies a function on each element of the dictionnary, with an
+ * additional parameter.
+ */
+void wsky_Dict_applyWithData(const wsky_Dict *self,
+                             void (*function)(const char *key, void *value,
+                                              void *data),
+                             void *data);
+
 /**
  * Returns `true` if the dictionnary contain an entry with the given key.
  */
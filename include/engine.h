@@ -0,0 +1,28 @@
+#ifndef ENGINE_H_
+# define ENGINE_H_
+
+/**
+ * @addtogroup whiskey
+ * @{
+ */
+
+/** The ways to run the code */
+typedef enum {
+  /** Walks the AST with wsky_evalNode() */
+  wsky_Engine_AST,
+
+  /** Compiles the AST to bytecode and runs it with the virtual machine */
+  wsky_Engine_BYTECODE,
+
+  /**
+   * Like wsky_Engine_BYTECODE, but the hot functions are compiled to
+   * machine code by the JIT compiler
+   */
+  wsky_Engine_JIT,
+} wsky_Engine;
+
+/**
+ * @}
+ */
+
+#endif /* !ENGINE_H_ */
@@ -3,6 +3,7 @@
 
 #include "ast.h"
 #include "objects/scope.h"
+#include "objects/method.h"
 
 wsky_ReturnValue wsky_doBinaryOperation(wsky_Value left,
                                         wsky_Operator operator,
@@ -30,4 +31,87 @@ wsky_Scope *wsky_eval_popScope(void);
 wsky_ReturnValue wsky_evalSequence(const wsky_SequenceNode *node,
                                    wsky_Scope *innerScope);
 
+
+
+/* Helpers shared with the bytecode virtual machine */
+
+/**
+ * Applies the operator of a binary operator node, specializing the node
+ * for the types of the operands it sees.
+ */
+wsky_ReturnValue wsky_eval_binaryOperator(const wsky_OperatorNode *node,
+                                          wsky_Value left,
+                                          wsky_Value right);
+
+wsky_ReturnValue wsky_eval_getVariable(const wsky_IdentifierNode *identifier,
+                                       wsky_Scope *scope);
+
+wsky_ReturnValue wsky_eval_declareVariable(const wsky_VarNode *node,
+                                           wsky_Value value,
+                                           wsky_Scope *scope);
+
+wsky_ReturnValue wsky_eval_assignVariable(const wsky_IdentifierNode *identifier,
+                                          wsky_Value value,
+                                          wsky_Scope *scope);
+
+wsky_ReturnValue wsky_eval_call(wsky_Value callee,
+                                unsigned parameterCount,
+                                wsky_Value *parameters);
+
+/**
+ * Like wsky_eval_call(), but uses wsky_Function_tailCall() if the
+ * callee is a function written in Whiskey.
+ */
+wsky_ReturnValue wsky_eval_tailCall(wsky_Value callee,
+                                    unsigned parameterCount,
+                                    wsky_Value *parameters);
+
+/**
+ * Creates the scope of a loop and pushes it on the scope stack.
+ */
+wsky_Scope *wsky_eval_enterLoop(const wsky_LoopNode *node,
+                                wsky_Scope *parent);
+
+/**
+ * Returns the scope of the next iteration of a loop.
+ *
+ * It is the same scope, with its variables undeclared, unless a
+ * function can capture it. In this case the scope of each iteration is
+ * a new one, kept by the functions created during the iteration.
+ */
+wsky_Scope *wsky_eval_nextIteration(wsky_Scope *scope);
+
+wsky_ReturnValue wsky_eval_getMember(wsky_Value object,
+                                     const wsky_MemberAccessNode *node,
+                                     wsky_Scope *scope);
+
+/**
+ * Returns the method called by `object.name(...)`, or NULL if the
+ * member is not a method and must be read with wsky_eval_getMember().
+ *
+ * Calling the method with wsky_eval_callMethod() doesn't create the
+ * InstanceMethod of the member.
+ */
+wsky_Method *wsky_eval_findMethod(wsky_Value object,
+                                  const wsky_MemberAccessNode *node,
+                                  wsky_Scope *scope);
+
+wsky_ReturnValue wsky_eval_callMethod(wsky_Method *method,
+                                      wsky_Value object,
+                                      unsigned parameterCount,
+                                      wsky_Value *parameters);
+
+/**
+ * Like wsky_eval_callMethod(), but uses wsky_Method_tailCall() if the
+ * receiver is an object.
+ */
+wsky_ReturnValue wsky_eval_tailCallMethod(wsky_Method *method,
+                                          wsky_Value object,
+                                          unsigned parameterCount,
+                                          wsky_Value *parameters);
+
+wsky_ReturnValue wsky_eval_setMember(wsky_Value object,
+                                     const wsky_MemberAccessNode *node,
+                                     wsky_Value value, wsky_Scope *scope);
+
 #endif /* !EVAL_H_ */
@@ -23,4 +23,33 @@ void wsky_GC_visitObject(void *object);
 void wsky_GC_visitValue(wsky_Value v);
 
 
+/**
+ * Keeps an object alive while it is referred to by something the
+ * garbage collector does not see, like a node of the AST.
+ *
+ * The roots are linked together, and are owned by the structure which
+ * refers to the object.
+ */
+typedef struct wsky_GCRoot_s {
+  /** The object, or NULL if the root is not added */
+  wsky_Object *object;
+
+  struct wsky_GCRoot_s *previous;
+  struct wsky_GCRoot_s *next;
+} wsky_GCRoot;
+
+/** A root which is not added */
+# define wsky_GCRoot_EMPTY ((wsky_GCRoot) {NULL, NULL, NULL})
+
+/** Adds a root which keeps the given object alive */
+void wsky_GC_addRoot(wsky_GCRoot *root, wsky_Object *object);
+
+/**
+ * Removes a root. Does nothing if it is not added.
+ *
+ * wsky_GC_deleteAll() removes all the roots, and deletes their objects.
+ */
+void wsky_GC_removeRoot(wsky_GCRoot *root);
+
+
 #endif /* !WSKY_GC_H_ */
@@ -0,0 +1,44 @@
+#ifndef ITERATOR_H_
+# define ITERATOR_H_
+
+# include "return_value.h"
+
+/**
+ * @defgroup Iterator Iterator
+ * The iteration protocol of the `for` loops.
+ *
+ * An iterator is a small struct which lives on the C stack of the
+ * evaluator or on the stack of the virtual machine, so that a loop
+ * allocates no iterator object. The iterable values are:
+ *  - the integers: `for i in n` iterates from 0 to `n - 1`;
+ *  - the strings: `for c in s` iterates over the characters of `s`.
+ *
+ * @{
+ */
+
+typedef struct {
+  /** The iterated value */
+  wsky_Value iterable;
+
+  /** The index of the next element */
+  wsky_int index;
+} wsky_Iterator;
+
+/**
+ * Initializes an iterator over a value, or raises a TypeError if the
+ * value is not iterable.
+ */
+wsky_ReturnValue wsky_Iterator_init(wsky_Iterator *iterator,
+                                    wsky_Value iterable);
+
+/**
+ * Returns false at the end of the iteration. Otherwise stores the next
+ * element in `*element` and returns true.
+ */
+bool wsky_Iterator_next(wsky_Iterator *iterator, wsky_Value *element);
+
+/**
+ * @}
+ */
+
+#endif /* !ITERATOR_H_ */
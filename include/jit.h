@@ -0,0 +1,63 @@
+#ifndef JIT_H_
+# define JIT_H_
+
+# include <stdbool.h>
+# include "code.h"
+
+/**
+ * @defgroup jit jit
+ * A baseline JIT compiler, which translates the bytecode of the hot
+ * functions to x86-64 machine code.
+ *
+ * Each instruction is translated to a template. Most templates call the
+ * instruction of the virtual machine, the jumps are native jumps, and
+ * the arithmetic and the comparisons on integers and floats, and the
+ * accesses to the resolved variables have an inline fast path.
+ *
+ * The machine code is written to memory which is never writable and
+ * executable at the same time.
+ *
+ * The JIT compiler is only available on x86-64 Linux, when the values
+ * are not NaN-boxed. It can be
+ * disabled with wsky_jit_setEnabled(), or with the `WSKY_NO_JIT`
+ * environment variable, and the code is then run by the virtual machine.
+ * @{
+ */
+
+/** The default value of wsky_jit_getThreshold() */
+# define wsky_jit_DEFAULT_THRESHOLD 100
+
+/** Returns true if the JIT compiler is available and enabled */
+bool wsky_jit_isEnabled(void);
+
+/**
+ * Enables or disables the JIT compiler.
+ *
+ * Enabling it does nothing if it is not available on this platform.
+ */
+void wsky_jit_setEnabled(bool enabled);
+
+/**
+ * Returns the number of runs of a function with wsky_Engine_JIT before
+ * its compilation to machine code.
+ */
+unsigned wsky_jit_getThreshold(void);
+
+void wsky_jit_setThreshold(unsigned runCount);
+
+/**
+ * Compiles a code to machine code, which is then used by wsky_vm_run().
+ *
+ * Returns false if the JIT compiler is disabled, or if the memory could
+ * not be mapped.
+ */
+bool wsky_jit_compile(wsky_Code *code);
+
+/** Frees the machine code of a code */
+void wsky_jit_free(wsky_Code *code);
+
+/**
+ * @}
+ */
+
+#endif /* !JIT_H_ */
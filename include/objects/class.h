@@ -4,6 +4,9 @@
 # include "object.h"
 # include "method.h"
 # include "dict.h"
+# include "operator.h"
+# include "scope_layout.h"
+# include "selector.h"
 
 
 extern const wsky_ClassDef wsky_Class_CLASS_DEF;
@@ -11,6 +14,62 @@ extern const wsky_ClassDef wsky_Class_CLASS_DEF;
 extern wsky_Class *wsky_Class_CLASS;
 
 
+/**
+ * The operator methods of a class, indexed by operator.
+ *
+ * The table is resolved through the superclasses, so that an operator
+ * dispatch is a single array access.
+ */
+typedef struct wsky_OperatorTable_s {
+  /** The binary operators, like `operator +` */
+  wsky_Method *binary[wsky_Operator_COUNT];
+
+  /** The reversed binary operators, like `operator r+` */
+  wsky_Method *reversed[wsky_Operator_COUNT];
+} wsky_OperatorTable;
+
+
+/** An entry of a method table */
+typedef struct {
+  /** The selector of the method, or -1 if the entry is empty */
+  int selector;
+
+  wsky_Method *method;
+} wsky_MethodTableEntry;
+
+/**
+ * The methods of a class, including the inherited ones, in a hash table
+ * indexed by selector.
+ *
+ * The number of entries is a power of two, at least twice the number of
+ * methods, so that the size of the table depends on the methods of the
+ * hierarchy of the class, and not on the number of selectors.
+ */
+typedef struct {
+  /** The entries, or NULL until wsky_Class_finalize() */
+  wsky_MethodTableEntry *entries;
+
+  /** The number of entries minus one */
+  unsigned mask;
+
+  /** The number of non-empty entries */
+  unsigned count;
+} wsky_MethodTable;
+
+/**
+ * The methods of a builtin class, including the inherited ones, indexed
+ * by builtin selector. The tables are static, the builtin classes do
+ * not use the hash tables of the other classes.
+ */
+typedef struct {
+  /** The methods and the getters */
+  wsky_Method *methods[wsky_Selector_BUILTIN_COUNT];
+
+  /** The setters */
+  wsky_Method *setters[wsky_Selector_BUILTIN_COUNT];
+} wsky_BuiltinMethodTable;
+
+
 /** A Whiskey class object */
 struct wsky_Class_s {
   wsky_OBJECT_HEAD
@@ -27,6 +86,15 @@ struct wsky_Class_s {
   /** The superclass */
   struct wsky_Class_s *super;
 
+  /** The number of superclasses */
+  unsigned depth;
+
+  /**
+   * The display of the class: its superclasses from the root, and the
+   * class itself at the index `depth`
+   */
+  struct wsky_Class_s **display;
+
   /** The methods and the getters */
   wsky_Dict *methods;
 
@@ -36,6 +104,42 @@ struct wsky_Class_s {
   /** The constructor */
   wsky_Method *constructor;
 
+  /** The operator methods, including the inherited ones */
+  wsky_OperatorTable *operators;
+
+  /** The methods and the getters, including the inherited ones */
+  wsky_MethodTable vtable;
+
+  /** The setters, including the inherited ones */
+  wsky_MethodTable setterTable;
+
+  /**
+   * The static table of the methods of a builtin class, used instead
+   * of `vtable` and `setterTable`, or NULL
+   */
+  wsky_BuiltinMethodTable *builtinTable;
+
+  /** True once wsky_Class_finalize() has built the tables */
+  bool finalized;
+
+  /**
+   * The methods written in C, or NULL. Their Method objects are created
+   * on their first lookup, except the operators and the setters.
+   */
+  const wsky_MethodDef *methodDefs;
+
+  /**
+   * The names of the private fields declared by this class, or NULL.
+   * They are computed by the resolver.
+   */
+  wsky_ScopeLayout *fields;
+
+  /**
+   * The index of the first field of this class in the fields of an
+   * object, after the fields of the superclasses.
+   */
+  unsigned fieldBase;
+
   /** The destructor or NULL */
   wsky_Method0 destructor;
 
@@ -44,10 +148,70 @@ struct wsky_Class_s {
 };
 
 
-wsky_Class *wsky_Class_new(const char *name, wsky_Class *super);
-wsky_Class *wsky_Class_newFromC(const wsky_ClassDef *def, wsky_Class *super);
+/**
+ * Creates a class written in Whiskey.
+ * @param fields The names of the private fields declared by the class,
+ * or NULL
+ */
+wsky_Class *wsky_Class_new(const char *name, wsky_Class *super,
+                           wsky_ScopeLayout *fields);
+
+/**
+ * Creates a builtin class.
+ * @param table The static table of the methods of the class
+ */
+wsky_Class *wsky_Class_newFromC(const wsky_ClassDef *def, wsky_Class *super,
+                                wsky_BuiltinMethodTable *table);
+
+/**
+ * Adds the methods of a class definition to a builtin class. Only the
+ * operators and the setters get a Method object now, the other ones
+ * get it on their first lookup. Their names must be in
+ * wsky_BUILTIN_SELECTORS.
+ */
 void wsky_Class_initMethods(wsky_Class *class, const wsky_ClassDef *def);
 
+/**
+ * Adds a method, a getter or a setter to the class.
+ * The constructor is not handled by this function.
+ * The class must not be finalized.
+ */
+void wsky_Class_addMethod(wsky_Class *class, wsky_Method *method);
+
+/**
+ * Builds the tables of the methods of the class, once its last method
+ * is added, and finalizes its superclasses first.
+ *
+ * The operators and the vtables include the inherited methods, so that
+ * a lookup does not depend on the depth of the hierarchy. A builtin
+ * class fills its static table instead of the vtables. The display
+ * is rebuilt too, since the superclass of a builtin class can be set
+ * after its creation. The methods of a class which is not finalized
+ * are looked up in the dictionaries of the class and of its
+ * superclasses.
+ *
+ * The default getters and setters get the index of their field, so
+ * that they read and write it without looking up its name.
+ */
+void wsky_Class_finalize(wsky_Class *class);
+
+/**
+ * Returns the number of private fields of the objects of the class,
+ * including the fields declared by the superclasses.
+ */
+static inline unsigned wsky_Class_getFieldCount(const wsky_Class *class) {
+  return class->fieldBase + (class->fields ? class->fields->count : 0);
+}
+
+/**
+ * Returns true if `sub` is `class` or one of its subclasses, with one
+ * lookup in the display of `sub`.
+ */
+static inline bool wsky_Class_isSubclass(const wsky_Class *sub,
+                                         const wsky_Class *class) {
+  return sub->depth >= class->depth && sub->display[class->depth] == class;
+}
+
 static inline bool wsky_isClass(wsky_Value value) {
   return wsky_getClass(value) == wsky_Class_CLASS;
 }
@@ -65,6 +229,31 @@ void wsky_Class_destroyObject(wsky_Object *object);
 
 
 
+/**
+ * The name of a member, with what the resolver knows about it, so that
+ * an access does not search the name.
+ */
+typedef struct {
+  const char *name;
+
+  /**
+   * The slot of the field in the layout of the class of a private
+   * access, or -1
+   */
+  int fieldSlot;
+
+  /** The selector of the name, or -1 if it is not known */
+  int selector;
+} wsky_MemberName;
+
+/** Returns a member name unknown to the resolver */
+static inline wsky_MemberName wsky_MemberName_fromString(const char *name) {
+  wsky_MemberName member = {name, -1, -1};
+  return member;
+}
+
+
+
 wsky_ReturnValue wsky_Class_getField(wsky_Class *class, wsky_Object *self,
                                      const char *name);
 
@@ -72,11 +261,11 @@ wsky_ReturnValue wsky_Class_callGetter(wsky_Object *self,
                                        wsky_Method *method, const char *name);
 
 wsky_ReturnValue wsky_Class_get(wsky_Class *class, wsky_Object *self,
-                                const char *attribute);
+                                const wsky_MemberName *member);
 
 wsky_ReturnValue wsky_Class_getPrivate(wsky_Class *class,
                                        wsky_Object *self,
-                                       const char *attribute);
+                                       const wsky_MemberName *member);
 
 
 
@@ -89,28 +278,58 @@ wsky_ReturnValue wsky_Class_callSetter(wsky_Object *self,
                                        wsky_Value value);
 
 wsky_ReturnValue wsky_Class_set(wsky_Class *class, wsky_Object *self,
-                                const char *attribute,
+                                const wsky_MemberName *member,
                                 wsky_Value value);
 
 wsky_ReturnValue wsky_Class_setPrivate(wsky_Class *class,
                                        wsky_Object *self,
-                                       const char *attribute,
+                                       const wsky_MemberName *member,
                                        wsky_Value value);
 
 
 
-/** Finds a method or a getter in this class, not in the superclasses */
+/**
+ * Finds a method or a getter in this class, not in the superclasses.
+ * Creates the Method object of a builtin method on its first lookup.
+ */
 wsky_Method *wsky_Class_findLocalMethod(wsky_Class *class, const char *name);
 
 /** Finds a method or a getter in this class and in the superclasses */
 wsky_Method *wsky_Class_findMethodOrGetter(wsky_Class *class,
                                            const char *name);
 
+/**
+ * Like wsky_Class_findMethodOrGetter(), with the selector of the name.
+ * Does not hash the name if the class is finalized.
+ */
+wsky_Method *wsky_Class_findMethodBySelector(wsky_Class *class,
+                                             unsigned selector);
+
 /** Finds a setter in this class and in the superclasses */
 wsky_Method *wsky_Class_findLocalSetter(wsky_Class *class, const char *name);
 
 /** Finds a setter in this class and in the superclasses */
 wsky_Method *wsky_Class_findSetter(wsky_Class *class, const char *name);
 
+/**
+ * Like wsky_Class_findSetter(), with the selector of the name.
+ * Does not hash the name if the class is finalized.
+ */
+wsky_Method *wsky_Class_findSetterBySelector(wsky_Class *class,
+                                             unsigned selector);
+
+
+/**
+ * Returns the method of a binary operator or NULL.
+ * @param reversed true to get the reversed operator, like `operator r+`
+ */
+static inline wsky_Method *wsky_Class_findBinaryOperator(
+  const wsky_Class *class, wsky_Operator operator, bool reversed) {
+
+  if (reversed)
+    return class->operators->reversed[operator];
+  return class->operators->binary[operator];
+}
+
 
 #endif /* CLASS_H */
@@ -17,7 +17,7 @@ extern const wsky_ClassDef wsky_Float_CLASS_DEF;
 extern wsky_Class *wsky_Float_CLASS;
 
 static inline bool wsky_isFloat(const wsky_Value value) {
-  return value.type == wsky_Type_FLOAT;
+  return wsky_Value_getType(value) == wsky_Type_FLOAT;
 }
 
 /**
@@ -36,8 +36,9 @@ typedef struct wsky_Function_s {
   wsky_Scope *globalScope;
 
   /**
-   * The duplicated AST node of the function, or NULL if the function
-   * is written in C
+   * The AST node of the function, shared with the parsed program and
+   * the other functions created from it, or NULL if the function is
+   * written in C
    */
   wsky_FunctionNode *node;
 
@@ -65,6 +66,76 @@ wsky_ReturnValue wsky_Function_callSelf(wsky_Function *function,
                                         unsigned parameterCount,
                                         const wsky_Value *parameters);
 
+
+/**
+ * Returns true if a function written in Whiskey takes the given number
+ * of parameters.
+ */
+bool wsky_Function_acceptsParameterCount(const wsky_Function *function,
+                                         unsigned parameterCount);
+
+/**
+ * Creates the scope of a call of a function written in Whiskey, with
+ * the parameters, and pushes it on the scope stack.
+ *
+ * The parameter count must be accepted by the function.
+ */
+wsky_Scope *wsky_Function_enterScope(wsky_Function *function,
+                                     wsky_Class *class,
+                                     wsky_Object *self,
+                                     const wsky_Value *parameters);
+
+/** Leaves a scope created by wsky_Function_enterScope() */
+void wsky_Function_leaveScope(wsky_Scope *scope);
+
+
+/** The maximum number of parameters of a tail call */
+# define wsky_Function_MAX_TAIL_CALL_PARAMETERS 32
+
+/**
+ * Returns true if the call can be made with wsky_Function_tailCall():
+ * the function must be written in Whiskey.
+ */
+static inline bool wsky_Function_canTailCall(const wsky_Function *function,
+                                             unsigned parameterCount) {
+  return function->node &&
+    parameterCount <= wsky_Function_MAX_TAIL_CALL_PARAMETERS;
+}
+
+/**
+ * Makes a call in tail position.
+ *
+ * The function is not called yet: this returns a special exception,
+ * which goes up to the wsky_Function_callSelf() running the caller. It
+ * leaves the scope of the caller, and then calls the function in the
+ * same C stack frame.
+ */
+wsky_ReturnValue wsky_Function_tailCall(wsky_Function *function,
+                                        unsigned parameterCount,
+                                        const wsky_Value *parameters);
+
+/**
+ * Like wsky_Function_tailCall(), but calls the function as a method
+ * of the given class, with the given receiver.
+ */
+wsky_ReturnValue wsky_Function_tailCallSelf(wsky_Function *function,
+                                            wsky_Class *class,
+                                            wsky_Object *self,
+                                            unsigned parameterCount,
+                                            const wsky_Value *parameters);
+
+/**
+ * Creates the exception returned by wsky_Function_tailCall().
+ * Called by wsky_start().
+ */
+void wsky_Function_initTailCall(void);
+
+/** Forgets the exception returned by wsky_Function_tailCall() */
+void wsky_Function_freeTailCall(void);
+
+/** Visits the pending tail call, for the garbage collector */
+void wsky_Function_visitTailCall(void);
+
 static inline wsky_ReturnValue wsky_Function_call(wsky_Function *function,
                                                   unsigned parameterCount,
                                                   const wsky_Value *params) {
@@ -74,9 +145,11 @@ static inline wsky_ReturnValue wsky_Function_call(wsky_Function *function,
 
 
 static inline bool wsky_isFunction(const wsky_Value value) {
-  if (value.type != wsky_Type_OBJECT)
+  if (wsky_Value_getType(value) != wsky_Type_OBJECT)
+    return false;
+  if (wsky_isNull(value))
     return false;
-  return value.v.objectValue->class == wsky_Function_CLASS;
+  return wsky_Value_getObject(value)->class == wsky_Function_CLASS;
 }
 
 
@@ -29,6 +29,12 @@ typedef struct wsky_Method_s {
    */
   wsky_Function *function;
 
+  /**
+   * The index of the field of a default getter or setter in the fields
+   * of the objects, set by wsky_Class_finalize(), or -1
+   */
+  int fieldIndex;
+
 } wsky_Method;
 
 /** Creates a new method from a C function */
@@ -45,6 +51,16 @@ wsky_Method *wsky_Method_newFromWskyDefault(const char *name,
                                             wsky_MethodFlags flags,
                                             wsky_Class *class);
 
+/**
+ * Returns true if the value is a method.
+ *
+ * The methods are never Whiskey values: a method read as a member is an
+ * InstanceMethod.
+ */
+static inline bool wsky_isMethod(wsky_Value value) {
+  return wsky_getClass(value) == wsky_Method_CLASS;
+}
+
 /**
  * Returns true if the method is a default getter or setter
  */
@@ -52,11 +68,35 @@ static inline bool wsky_Method_isDefault(const wsky_Method *method) {
   return !method->function;
 }
 
+/**
+ * Calls a method. An operator method which does not support its
+ * operand raises a TypeError.
+ */
 wsky_ReturnValue wsky_Method_call(wsky_Method *method,
                                   wsky_Object *self,
                                   unsigned parameterCount,
                                   const wsky_Value *parameters);
 
+/**
+ * Calls an operator method for the operator dispatch. Unlike
+ * wsky_Method_call(), an operator which does not support its operand
+ * returns wsky_ReturnValue_NOT_IMPLEMENTED, so that the dispatch tries
+ * the other operand.
+ */
+wsky_ReturnValue wsky_Method_callOperator(wsky_Method *method,
+                                          wsky_Object *self,
+                                          wsky_Value right);
+
+/**
+ * Calls a method in tail position, like wsky_Function_tailCall().
+ * Falls back to wsky_Method_call() if the method is not written in
+ * Whiskey.
+ */
+wsky_ReturnValue wsky_Method_tailCall(wsky_Method *method,
+                                      wsky_Object *self,
+                                      unsigned parameterCount,
+                                      const wsky_Value *parameters);
+
 wsky_ReturnValue wsky_Method_call0(wsky_Method *method,
                                    wsky_Object *self);
 
@@ -26,6 +26,15 @@ typedef struct wsky_NotImplementedError_s {
 
 wsky_NotImplementedError *wsky_NotImplementedError_new(const char *message);
 
+/**
+ * Creates the exception of wsky_ReturnValue_NOT_IMPLEMENTED.
+ * Called by wsky_start().
+ */
+void wsky_NotImplementedError_initSingleton(void);
+
+/** Forgets the exception of wsky_ReturnValue_NOT_IMPLEMENTED */
+void wsky_NotImplementedError_freeSingleton(void);
+
 /**
  * @}
  * @}
@@ -3,6 +3,7 @@
 
 # include "return_value.h"
 # include "dict.h"
+# include "operator.h"
 
 /**
  * @defgroup objects objects
@@ -38,30 +39,31 @@
 
 
 /**
- * Represents the private fields of an object.
+ * A private field of an object.
  */
-typedef struct wsky_ObjectFields_s {
+typedef struct {
+  /** The value of the field */
+  wsky_Value value;
 
-  /**
-   * The fields of the superclass or NULL if the
-   * superclass is native
-   */
-  struct wsky_ObjectFields_s *parent;
-
-  /** A dictionnary of the fields */
-  wsky_Dict fields;
-
-} wsky_ObjectFields;
+  /** False until the field is set */
+  bool defined;
+} wsky_ObjectField;
 
+/**
+ * A private field which is not in the layout of its class: a field of
+ * a class whose AST is not resolved, or a field set through another
+ * expression than `@`.
+ */
+typedef struct wsky_DynamicField_s {
+  struct wsky_DynamicField_s *next;
 
-/** For garbage collection */
-void wsky_ObjectFields_acceptGc(wsky_ObjectFields *fields);
+  /** The class which owns the field */
+  struct wsky_Class_s *class;
 
-void wsky_ObjectFields_free(wsky_ObjectFields *fields);
+  char *name;
 
-/** For debugging purposes */
-void wsky_ObjectFields_print(wsky_ObjectFields *fields,
-                             const wsky_Class *class);
+  wsky_ObjectField field;
+} wsky_DynamicField;
 
 
 /**
@@ -81,10 +83,14 @@ struct wsky_Object_s {
   wsky_OBJECT_HEAD
 
   /**
-   * The private fields. Exists only if the class of the object
-   * is non-native.
+   * The private fields of the object, declared by its class and by
+   * the superclasses, or NULL if there is none. The fields of a class
+   * start at the index wsky_Class::fieldBase.
    */
-  wsky_ObjectFields fields;
+  wsky_ObjectField *fields;
+
+  /** The fields which are not in the layouts of the classes */
+  wsky_DynamicField *dynamicFields;
 };
 
 
@@ -124,6 +130,9 @@ const char *wsky_Object_getClassName(const wsky_Object *o);
 /** Returns `true` if the given object is an instance of the given class */
 bool wsky_Object_isA(const wsky_Object *object, const wsky_Class *class);
 
+/** Frees the private fields of an object of a non-native class */
+void wsky_Object_freeFields(wsky_Object *object);
+
 
 struct wsky_Method_s;
 
@@ -193,6 +202,17 @@ wsky_ReturnValue wsky_Object_callMethod3(wsky_Object *object,
                                     wsky_Value b,
                                     wsky_Value c);
 
+/**
+ * Calls the method of a binary operator, like `operator +`, or the
+ * reversed one, like `operator r+`.
+ *
+ * Raises an exception if the class has no such operator.
+ */
+wsky_ReturnValue wsky_Object_callBinaryOperator(wsky_Object *object,
+                                                wsky_Operator operator,
+                                                bool reversed,
+                                                wsky_Value right);
+
 /** Returns a wsky_String or an exception */
 wsky_ReturnValue wsky_Object_toString(wsky_Object *object);
 
@@ -6,6 +6,7 @@
 # include "object.h"
 # include "class_def.h"
 # include "module.h"
+# include "scope_layout.h"
 
 /**
  * @addtogroup objects
@@ -31,9 +32,18 @@ typedef struct wsky_Scope_s {
   /** The parent scope or NULL */
   struct wsky_Scope_s *parent;
 
-  /** A dictionnary of the variables */
+  /** A dictionnary of the variables which have no slot */
   wsky_Dict variables;
 
+  /** The layout of the slots, or NULL */
+  wsky_ScopeLayout *layout;
+
+  /** The values of the variables of the layout */
+  wsky_Value *slots;
+
+  /** `true` if the variable of the slot is declared */
+  bool *declared;
+
   /**
    * The current class or NULL.
    * Don't mix up it with `class`. The class of a scope object is
@@ -49,6 +59,12 @@ typedef struct wsky_Scope_s {
    */
   wsky_Module *module;
 
+  /**
+   * `true` if the scope is allocated on the frame stack instead of
+   * being a garbage-collected object.
+   */
+  bool frame;
+
 } wsky_Scope;
 
 
@@ -58,10 +74,52 @@ typedef struct wsky_Scope_s {
 wsky_Scope *wsky_Scope_new(wsky_Scope *parent, wsky_Class *class,
                            wsky_Object *self);
 
+/**
+ * Creates a new Scope with the slots of the given layout.
+ * The variables of the slots are not declared yet.
+ *
+ * @param layout The layout or NULL
+ */
+wsky_Scope *wsky_Scope_newWithLayout(wsky_Scope *parent, wsky_Class *class,
+                                     wsky_Object *self,
+                                     wsky_ScopeLayout *layout);
+
+/**
+ * Creates the scope of a sequence or a function call.
+ *
+ * If the layout is not captured by any function, the scope is allocated
+ * on the frame stack and must be freed with wsky_Scope_leave() in
+ * reverse order of creation. Otherwise it is a new garbage-collected
+ * Scope.
+ *
+ * @param layout The layout or NULL
+ */
+wsky_Scope *wsky_Scope_enter(wsky_Scope *parent, wsky_Class *class,
+                             wsky_Object *self,
+                             wsky_ScopeLayout *layout);
+
+/**
+ * Frees a scope created by wsky_Scope_enter() if it is on the frame
+ * stack.
+ */
+void wsky_Scope_leave(wsky_Scope *scope);
+
+/**
+ * Frees the memory of the frame stack. The stack must be empty.
+ */
+void wsky_Scope_freeFrameStack(void);
+
+/**
+ * Visits a scope for the garbage collector, whether it is an object
+ * or a frame.
+ */
+void wsky_Scope_visit(wsky_Scope *scope);
+
 /**
  * Creates a new root scope.
  *
- * Its parent is NULL and it contains some builtins.
+ * Its parent is NULL. The builtins are not copied into it, they are
+ * found by the lookups after the root scope.
  *
  * @param module The module.
  */
@@ -88,6 +146,48 @@ void wsky_Scope_print(const wsky_Scope *scope);
 void wsky_Scope_addVariable(wsky_Scope *scope,
                             const char *name, wsky_Value value);
 
+/**
+ * Returns the scope of the given lexical address, going up `depth`
+ * parent scopes.
+ */
+static inline wsky_Scope *wsky_Scope_getAncestor(wsky_Scope *scope,
+                                                 int depth) {
+  while (depth--)
+    scope = scope->parent;
+  return scope;
+}
+
+/**
+ * Returns a pointer to the variable of the given lexical address, or
+ * NULL if it is not declared yet.
+ */
+static inline wsky_Value *wsky_Scope_getSlot(wsky_Scope *scope,
+                                             wsky_LexicalAddress address) {
+  scope = wsky_Scope_getAncestor(scope, address.depth);
+  if (!scope->declared[address.slot])
+    return NULL;
+  return scope->slots + address.slot;
+}
+
+/**
+ * Declares a variable in a slot of the scope.
+ * Returns true on error (if the variable is already declared)
+ */
+static inline bool wsky_Scope_declareSlot(wsky_Scope *scope, int slot,
+                                          wsky_Value value) {
+  if (scope->declared[slot])
+    return true;
+  scope->declared[slot] = true;
+  scope->slots[slot] = value;
+  return false;
+}
+
+/**
+ * Undeclares the variables of the slots, so that a loop can evaluate
+ * its body again in the same scope.
+ */
+void wsky_Scope_undeclareSlots(wsky_Scope *scope);
+
 /**
  * Looks for a variable and return its value.
  * Calls abort() if the variable is not found.
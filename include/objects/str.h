@@ -30,12 +30,20 @@ struct wsky_String_s {
 
 wsky_String *wsky_String_new(const char *cString);
 
+/**
+ * Returns the String of a single character, which must not be '\0'.
+ *
+ * The Strings of the characters are created once, and kept alive by
+ * the garbage collector until wsky_GC_deleteAll().
+ */
+wsky_String *wsky_String_getCharacter(char character);
+
 static inline bool wsky_isString(const wsky_Value value) {
-  if (value.type != wsky_Type_OBJECT)
+  if (wsky_Value_getType(value) != wsky_Type_OBJECT)
     return false;
   if (wsky_isNull(value))
     return false;
-  return value.v.objectValue->class == wsky_String_CLASS;
+  return wsky_Value_getObject(value)->class == wsky_String_CLASS;
 }
 
 wsky_ReturnValue wsky_String_equals(wsky_String *self,
@@ -49,6 +57,10 @@ wsky_ReturnValue wsky_String_contains(wsky_String *self,
 
 void wsky_String_print(const wsky_String *self);
 
+/** Returns a new string made of the two given strings */
+wsky_String *wsky_String_concat(const wsky_String *left,
+                                const wsky_String *right);
+
 
 
 char *wsky_String_escapeCString(const char *source);
@@ -3,6 +3,7 @@
 
 # include "object.h"
 # include "class_def.h"
+# include "shape.h"
 
 /**
  * @addtogroup objects
@@ -18,11 +19,26 @@ extern const wsky_ClassDef wsky_Structure_CLASS_DEF;
 extern wsky_Class *wsky_Structure_CLASS;
 
 
+/** The number of values stored in the Structure itself */
+# define wsky_Structure_INLINE_COUNT 4
+
 /** A Structure */
 typedef struct wsky_Structure_s {
   wsky_OBJECT_HEAD
 
-  wsky_Dict members;
+  /** The names of the members */
+  wsky_Shape *shape;
+
+  /**
+   * The values of the members, indexed by their slots in the shape.
+   * Points to `inlineValues` or to a malloc'd array.
+   */
+  wsky_Value *values;
+
+  /** The allocated length of `values` */
+  unsigned capacity;
+
+  wsky_Value inlineValues[wsky_Structure_INLINE_COUNT];
 } wsky_Structure;
 
 /**
@@ -45,6 +61,25 @@ wsky_ReturnValue wsky_Structure_set(wsky_Structure *self,
  */
 wsky_ReturnValue wsky_Structure_get(wsky_Structure *self, const char *name);
 
+/**
+ * Like wsky_Structure_get(), but does not search the member if the
+ * structure has the shape of the cache.
+ */
+wsky_ReturnValue wsky_Structure_getCached(wsky_Structure *self,
+                                          const char *name,
+                                          wsky_ShapeCache *cache);
+
+/**
+ * Like wsky_Structure_set(), but does not search the member if the
+ * structure has the shape of the cache. If the store adds the member,
+ * the cache keeps the new shape, so that the next structures of the
+ * same shape take the same transition.
+ */
+wsky_ReturnValue wsky_Structure_setCached(wsky_Structure *self,
+                                          const char *name,
+                                          wsky_Value value,
+                                          wsky_ShapeCache *cache);
+
 /**
  * @}
  * @}
@@ -29,6 +29,14 @@ struct wsky_TypeError_s {
 
 wsky_TypeError *wsky_TypeError_new(const char *message);
 
+/**
+ * Raises the TypeError of a binary operator which does not support its
+ * operands, like `Unsupported classes for +: String and Integer`.
+ */
+wsky_ReturnValue wsky_TypeError_raiseUnsupportedOperands(const char *leftClass,
+                                                         const char *operator,
+                                                         wsky_Value right);
+
 /**
  * @}
  * @}
@@ -53,6 +53,9 @@ typedef enum {
   wsky_Operator_AT,
 } wsky_Operator;
 
+/** The number of operators */
+# define wsky_Operator_COUNT (wsky_Operator_AT + 1)
+
 
 /**
  * Returns the string of the operator.
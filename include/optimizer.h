@@ -0,0 +1,46 @@
+#ifndef OPTIMIZER_H_
+# define OPTIMIZER_H_
+
+# include "ast.h"
+
+/**
+ * @defgroup optimizer optimizer
+ * Simplifies the AST before its evaluation.
+ *
+ * The optimizer:
+ *  - folds the operators whose operands are literals (integers, floats,
+ *    booleans, null or strings) into a literal, by applying the operator
+ *    with the evaluator, so the result is always the same;
+ *  - removes the branches of an `if` whose test is a boolean literal,
+ *    and the `while` loops whose test is `false`;
+ *  - removes the parentheses around a literal.
+ *
+ * The operators which raise an exception are not folded, so that the
+ * exception is raised at run time.
+ *
+ * It runs before the resolver, on the nodes given to wsky_evalString(),
+ * wsky_evalFile() and the REPL. It can be disabled with
+ * wsky_optimizer_setEnabled() or with the `WSKY_NO_OPTIMIZER`
+ * environment variable.
+ *
+ * @{
+ */
+
+/** Returns true if wsky_optimize() does something */
+bool wsky_optimizer_isEnabled(void);
+
+void wsky_optimizer_setEnabled(bool enabled);
+
+/**
+ * Optimizes a node and its children.
+ *
+ * Returns the node which replaces it, the given one may be deleted.
+ * The root sequence of a program is never replaced.
+ */
+wsky_ASTNode *wsky_optimize(wsky_ASTNode *node);
+
+/**
+ * @}
+ */
+
+#endif /* !OPTIMIZER_H_ */
@@ -2,9 +2,10 @@
 # define REPL_H_
 
 # include <stdbool.h>
+# include "engine.h"
 
 
 /* Read Eval Print Loop */
-void wsky_repl(bool debugMode);
+void wsky_repl(bool debugMode, wsky_Engine engine);
 
 #endif /* !REPL_H_ */
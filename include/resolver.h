@@ -0,0 +1,48 @@
+#ifndef RESOLVER_H_
+# define RESOLVER_H_
+
+# include "ast.h"
+
+/**
+ * @defgroup resolver resolver
+ * Computes the lexical addresses of the variables.
+ *
+ * The resolver gives a layout to the nodes which create a scope (the
+ * sequences, the functions and the loops) and a (depth, slot) address to the
+ * identifiers and the variable declarations, so that the evaluator can
+ * access the variables without looking up their names.
+ *
+ * It also finds the scopes which can be captured by a function. The
+ * other ones are allocated on the frame stack.
+ *
+ * And it marks the calls in tail position: the last node of a function,
+ * the last node of a sequence in tail position, and the branches of an
+ * `if` in tail position.
+ *
+ * The classes get the names of their private fields, so that the
+ * fields of an object are stored in slots instead of a dictionary.
+ *
+ * The variables of a root scope have no address, because they are
+ * added dynamically (the builtins, the lines of the REPL...). Neither
+ * have the variables of the nodes which are not resolved.
+ *
+ * @{
+ */
+
+/**
+ * Resolves a node which will be evaluated with wsky_evalNode() in a
+ * root scope.
+ */
+void wsky_resolve(wsky_ASTNode *node);
+
+/**
+ * Resolves a sequence which will be evaluated with wsky_evalSequence()
+ * in a root scope, like the lines of the REPL.
+ */
+void wsky_resolveSequence(wsky_SequenceNode *node);
+
+/**
+ * @}
+ */
+
+#endif /* !RESOLVER_H_ */
@@ -42,6 +42,15 @@ extern const wsky_ReturnValue wsky_ReturnValue_NULL;
 /** A predefined return value for `0` */
 extern const wsky_ReturnValue wsky_ReturnValue_ZERO;
 
+/**
+ * A predefined return value raising a NotImplementedError.
+ *
+ * The operators return it when they don't support their operands, so
+ * that trying the next candidate of a binary operation never allocates.
+ * It is initialized by wsky_start().
+ */
+extern wsky_ReturnValue wsky_ReturnValue_NOT_IMPLEMENTED;
+
 static inline wsky_ReturnValue wsky_ReturnValue_fromBool(bool n) {
   return n ? wsky_ReturnValue_TRUE : wsky_ReturnValue_FALSE;
 }
@@ -120,6 +129,9 @@ wsky_ReturnValue wsky_ReturnValue_newException(const char *message);
 # define wsky_RAISE_NEW_ATTRIBUTE_ERROR(message)                        \
   wsky_RAISE_EXCEPTION((wsky_Exception *)wsky_AttributeError_new(message))
 
+# define wsky_RETURN_NOT_IMPLEMENTED            \
+  return wsky_ReturnValue_NOT_IMPLEMENTED
+
 # define wsky_RAISE_NEW_NOT_IMPLEMENTED_ERROR(message)                  \
   wsky_RAISE_EXCEPTION((wsky_Exception *)wsky_NotImplementedError_new(message))
 
@@ -0,0 +1,86 @@
+#ifndef SCOPE_LAYOUT_H_
+# define SCOPE_LAYOUT_H_
+
+# include <stdbool.h>
+
+/**
+ * @defgroup ScopeLayout ScopeLayout
+ * @{
+ */
+
+/**
+ * The names of the variables declared in a scope, computed by the
+ * resolver.
+ *
+ * The variable of index `i` is stored in the slot `i` of the scope.
+ * A layout is shared by the node which creates the scope and by the
+ * copies of this node.
+ */
+typedef struct wsky_ScopeLayout_s {
+  /** The number of owners of the layout */
+  unsigned referenceCount;
+
+  /** The number of variables */
+  unsigned count;
+
+  /** The allocated length of `names` */
+  unsigned capacity;
+
+  /** The names of the variables */
+  char **names;
+
+  /**
+   * `true` if a function created in the scope or in one of its inner
+   * scopes can capture it. Otherwise the scope does not outlive its
+   * node and can be allocated on the frame stack.
+   */
+  bool captured;
+} wsky_ScopeLayout;
+
+
+/** Returns a new empty layout, with a reference count of 1 */
+wsky_ScopeLayout *wsky_ScopeLayout_new(void);
+
+/** Increments the reference count and returns the layout */
+wsky_ScopeLayout *wsky_ScopeLayout_retain(wsky_ScopeLayout *layout);
+
+/** Decrements the reference count and deletes the layout if needed */
+void wsky_ScopeLayout_release(wsky_ScopeLayout *layout);
+
+/**
+ * Adds a variable if the layout does not contain it yet.
+ * Returns the slot of the variable.
+ */
+int wsky_ScopeLayout_add(wsky_ScopeLayout *layout, const char *name);
+
+/** Returns the slot of a variable or -1 */
+int wsky_ScopeLayout_find(const wsky_ScopeLayout *layout, const char *name);
+
+
+
+/**
+ * The lexical address of a variable, computed by the resolver.
+ */
+typedef struct {
+  /**
+   * The number of parent scopes to go up to find the variable,
+   * or -1 if the variable is not resolved.
+   */
+  int depth;
+
+  /** The slot of the variable in its scope */
+  int slot;
+} wsky_LexicalAddress;
+
+/** The address of an unresolved variable */
+# define wsky_LexicalAddress_UNRESOLVED ((wsky_LexicalAddress) {-1, -1})
+
+static inline bool wsky_LexicalAddress_isResolved(wsky_LexicalAddress a) {
+  return a.depth >= 0;
+}
+
+/**
+ * @}
+ */
+
+#endif /* !SCOPE_LAYOUT_H_ */
@@ -0,0 +1,78 @@
+#ifndef SELECTOR_H_
+# define SELECTOR_H_
+
+/**
+ * @defgroup selector selector
+ * The interned names of the methods.
+ *
+ * Each name of a method, a getter or a setter gets a small integer, its
+ * selector, which is the key of the tables of methods of the classes. The
+ * selectors are freed by wsky_stop().
+ *
+ * The names of the methods of the builtin classes are interned first,
+ * in the order of wsky_BUILTIN_SELECTORS, so that their selectors are
+ * known at compile time. The builtin classes index their static method
+ * tables with them.
+ *
+ * @{
+ */
+
+/** The names of the methods of the builtin classes */
+# define wsky_BUILTIN_SELECTORS(X)              \
+  X(TO_STRING, "toString")                      \
+  X(CLASS, "class")                             \
+  X(LENGTH, "length")                           \
+  X(INDEX_OF, "indexOf")                        \
+  X(RAISE, "raise")                             \
+  X(SUPER, "super")                             \
+  X(GET, "get")                                 \
+  X(SET, "set")                                 \
+  X(INIT, "init")                               \
+  X(EQUALS, "operator ==")                      \
+  X(NOT_EQUALS, "operator !=")                  \
+  X(PLUS, "operator +")                         \
+  X(MINUS, "operator -")                        \
+  X(STAR, "operator *")                         \
+  X(SLASH, "operator /")                        \
+  X(R_EQUALS, "operator r==")                   \
+  X(R_NOT_EQUALS, "operator r!=")               \
+  X(R_PLUS, "operator r+")                      \
+  X(R_MINUS, "operator r-")                     \
+  X(R_STAR, "operator r*")                      \
+  X(R_SLASH, "operator r/")
+
+/** The selectors of the names of wsky_BUILTIN_SELECTORS */
+typedef enum {
+# define X(id, name) wsky_Selector_ ## id,
+  wsky_BUILTIN_SELECTORS(X)
+# undef X
+
+  /** The number of builtin selectors */
+  wsky_Selector_BUILTIN_COUNT
+} wsky_BuiltinSelector;
+
+/** Returns the selector of a name, and interns the name if needed */
+unsigned wsky_selector_intern(const char *name);
+
+/** Returns the selector of a name, or -1 if it is not interned */
+int wsky_selector_find(const char *name);
+
+/** Returns the name of a selector */
+const char *wsky_selector_getName(unsigned selector);
+
+/** Returns the number of interned names */
+unsigned wsky_selector_getCount(void);
+
+/**
+ * Returns the number of names looked up by wsky_selector_find() since
+ * the start, to check that a path does not hash names.
+ */
+unsigned long wsky_selector_getFindCount(void);
+
+void wsky_selector_free(void);
+
+/**
+ * @}
+ */
+
+#endif /* !SELECTOR_H_ */
@@ -0,0 +1,83 @@
+#ifndef SHAPE_H_
+# define SHAPE_H_
+
+/**
+ * @defgroup Shape Shape
+ * The layouts of the members of the structures.
+ *
+ * A shape is the list of the member names of a structure, in insertion
+ * order. The member of index `i` is stored in the slot `i` of the
+ * structure. The structures which got the same members in the same
+ * order share the same shape, so a member access can remember the slot
+ * of the member for a shape.
+ *
+ * The shapes form a tree rooted at the empty shape. They are freed by
+ * wsky_stop().
+ *
+ * @{
+ */
+
+/** A shape */
+typedef struct wsky_Shape_s {
+  /** The shape without the last member, or NULL for the empty shape */
+  struct wsky_Shape_s *parent;
+
+  /** The name of the last member, or NULL for the empty shape */
+  char *name;
+
+  /** The number of members */
+  unsigned count;
+
+  /** The first shape with one more member than this one */
+  struct wsky_Shape_s *transitions;
+
+  /** The next shape in the transitions of the parent */
+  struct wsky_Shape_s *next;
+} wsky_Shape;
+
+
+/** The slot of a member in the last shape seen by a member access */
+typedef struct {
+  /** The shape or NULL */
+  const wsky_Shape *shape;
+
+  unsigned slot;
+
+  /**
+   * The shape of a structure after a store which adds the member, or
+   * NULL if the member is in `shape`
+   */
+  wsky_Shape *transition;
+} wsky_ShapeCache;
+
+/** An empty cache */
+# define wsky_ShapeCache_EMPTY ((wsky_ShapeCache) {NULL, 0, NULL})
+
+
+/** Returns the shape without members */
+wsky_Shape *wsky_Shape_getEmpty(void);
+
+/**
+ * Returns the shape with the members of the given one and a new member
+ * at the end. The given shape must not contain the name.
+ */
+wsky_Shape *wsky_Shape_addMember(wsky_Shape *shape, const char *name);
+
+/** Returns the slot of a member or -1 */
+int wsky_Shape_find(const wsky_Shape *shape, const char *name);
+
+/**
+ * Like wsky_Shape_find(), but does not search the member if the shape
+ * is the one of the cache. Updates the cache.
+ */
+int wsky_Shape_findCached(const wsky_Shape *shape, const char *name,
+                          wsky_ShapeCache *cache);
+
+/** Deletes all the shapes */
+void wsky_Shape_freeAll(void);
+
+/**
+ * @}
+ */
+
+#endif /* !SHAPE_H_ */
@@ -0,0 +1,43 @@
+#ifndef STACK_H_
+# define STACK_H_
+
+# include "value.h"
+
+/**
+ * @defgroup stack stack
+ * The stack of values shared by the virtual machine and the evaluator.
+ *
+ * The operand stacks of the running codes and the parameters of the
+ * calls are allocated on it, in the order of the calls. A caller
+ * evaluates the parameters in place, and the callee reads them as an
+ * array, so they are not copied and their count is not limited.
+ *
+ * The stack is made of a list of chunks on the heap. The garbage
+ * collector visits its values with wsky_stack_visit().
+ *
+ * @{
+ */
+
+/**
+ * Allocates `count` values on the top of the stack, initialized to
+ * `null`.
+ */
+wsky_Value *wsky_stack_allocate(size_t count);
+
+/**
+ * Releases the given values and the ones allocated after them.
+ * `values` is a pointer returned by wsky_stack_allocate().
+ */
+void wsky_stack_release(wsky_Value *values);
+
+/** Visits the values of the stack, for the garbage collector */
+void wsky_stack_visit(void);
+
+/** Frees the memory of the stack. It must be empty. */
+void wsky_stack_free(void);
+
+/**
+ * @}
+ */
+
+#endif /* !STACK_H_ */
@@ -3,6 +3,7 @@
 
 # include <stddef.h>
 # include <stdarg.h>
+# include <stdint.h>
 
 /**
  * Like asprintf(), except that it returns the pointer instead of a parameter.
@@ -17,4 +18,7 @@ char *wsky_strdup(const char *string);
 /** Like strndup() */
 char *wsky_strndup(const char *string, size_t maximum);
 
+/** Returns the FNV-1a hash of a string */
+uint32_t wsky_hashString(const char *string);
+
 #endif /* !STRING_UTILS_H_ */
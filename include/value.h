@@ -3,6 +3,7 @@
 
 #include "type.h"
 #include <stdarg.h>
+#include <string.h>
 
 typedef struct wsky_Class_s wsky_Class;
 typedef struct wsky_String_s wsky_String;
@@ -23,12 +24,139 @@ typedef enum {
   wsky_Type_OBJECT
 } wsky_Type;
 
+#ifdef WSKY_NAN_BOXING
+
+/**
+ * A Whiskey value.
+ *
+ * Integers, booleans and floats are not objects, and are not
+ * garbage-collected.
+ * This structure can hold any Whiskey value, whatever its type.
+ *
+ * The value is NaN-boxed in 8 bytes. A float is stored as is, and all
+ * its NaNs are the same quiet NaN. The other values are stored in the
+ * payload of the negative quiet NaNs: the 16 upper bits are the tag of
+ * the type and the 48 lower bits are the pointer, the integer or the
+ * boolean.
+ *
+ * An integer is 48 bits wide. The lexer rejects the bigger literals, and
+ * like with the unboxed values, an Integer operation whose result is not
+ * between wsky_Value_INT_MIN and wsky_Value_INT_MAX gives a Float.
+ *
+ * The members must be read with wsky_Value_getType() and the other
+ * getters.
+ */
+typedef struct wsky_Value_s {
+  /** The bits of the float, or the tag and the payload */
+  uint64_t bits;
+} wsky_Value;
+
+/** The bits of the tag */
+# define wsky_Value_TAG_MASK    UINT64_C(0xffff000000000000)
+
+/** The bits of the payload */
+# define wsky_Value_PAYLOAD_MASK UINT64_C(0x0000ffffffffffff)
+
+# define wsky_Value_OBJECT_TAG  UINT64_C(0xfffc000000000000)
+# define wsky_Value_INT_TAG     UINT64_C(0xfffd000000000000)
+# define wsky_Value_BOOL_TAG    UINT64_C(0xfffe000000000000)
+
+/** The NaN which replaces all the others */
+# define wsky_Value_NAN_BITS    UINT64_C(0x7ff8000000000000)
+
+/** The lowest integer of a wsky_Value */
+# define wsky_Value_INT_MIN     (-(INT64_C(1) << 47))
+
+/** The highest integer of a wsky_Value */
+# define wsky_Value_INT_MAX     ((INT64_C(1) << 47) - 1)
+
+/** Initializes a constant wsky_Value from a boolean */
+# define wsky_Value_INIT_BOOL(b) {wsky_Value_BOOL_TAG | ((b) ? 1 : 0)}
+
+/** Initializes a constant wsky_Value from an integer */
+# define wsky_Value_INIT_INT(n)                                 \
+  {wsky_Value_INT_TAG | ((uint64_t)(n) & wsky_Value_PAYLOAD_MASK)}
+
+/** Initializes the constant wsky_Value `null` */
+# define wsky_Value_INIT_NULL {wsky_Value_OBJECT_TAG}
+
+/** Returns the type of a value */
+static inline wsky_Type wsky_Value_getType(wsky_Value value) {
+  switch (value.bits & wsky_Value_TAG_MASK) {
+  case wsky_Value_OBJECT_TAG: return wsky_Type_OBJECT;
+  case wsky_Value_INT_TAG: return wsky_Type_INT;
+  case wsky_Value_BOOL_TAG: return wsky_Type_BOOL;
+  default: return wsky_Type_FLOAT;
+  }
+}
+
+/** Returns the boolean of a value of type wsky_Type_BOOL */
+static inline bool wsky_Value_getBool(wsky_Value value) {
+  return value.bits & 1;
+}
+
+/** Returns the integer of a value of type wsky_Type_INT */
+static inline wsky_int wsky_Value_getInt(wsky_Value value) {
+  /* Sign-extends the 48 bits */
+  const uint64_t sign = UINT64_C(1) << 47;
+  uint64_t payload = value.bits & wsky_Value_PAYLOAD_MASK;
+  return (wsky_int)(payload ^ sign) - (wsky_int)sign;
+}
+
+/** Returns the float of a value of type wsky_Type_FLOAT */
+static inline wsky_float wsky_Value_getFloat(wsky_Value value) {
+  wsky_float n;
+  memcpy(&n, &value.bits, sizeof(n));
+  return n;
+}
+
+/** Returns the object of a value of type wsky_Type_OBJECT */
+static inline wsky_Object *wsky_Value_getObject(wsky_Value value) {
+  return (wsky_Object *)(uintptr_t)(value.bits & wsky_Value_PAYLOAD_MASK);
+}
+
+/** Creates a new value from a boolean */
+static inline wsky_Value wsky_Value_fromBool(bool n) {
+  wsky_Value v = wsky_Value_INIT_BOOL(n);
+  return v;
+}
+
+/** Creates a new value from a wsky_Object */
+static inline wsky_Value wsky_Value_fromObject(wsky_Object *object) {
+  wsky_Value v = {wsky_Value_OBJECT_TAG | (uint64_t)(uintptr_t)object};
+  return v;
+}
+
+/** Creates a new value from an integer, which wraps around to 48 bits */
+static inline wsky_Value wsky_Value_fromInt(wsky_int n) {
+  wsky_Value v = wsky_Value_INIT_INT(n);
+  return v;
+}
+
+/** Creates a new value from a float */
+static inline wsky_Value wsky_Value_fromFloat(wsky_float n) {
+  wsky_Value v;
+  if (n != n)
+    v.bits = wsky_Value_NAN_BITS;
+  else
+    memcpy(&v.bits, &n, sizeof(n));
+  return v;
+}
+
+#else /* !WSKY_NAN_BOXING */
+
 /**
  * A Whiskey value.
  *
  * Integers, booleans and floats are not objects, and are not
  * garbage-collected.
  * This structure can hold any Whiskey value, whatever its type.
+ *
+ * An integer is 64 bits wide. An Integer operation whose result does
+ * not fit gives a Float.
+ *
+ * The members should be read with wsky_Value_getType() and the other
+ * getters, which also work when the values are NaN-boxed.
  */
 typedef struct wsky_Value_s {
 
@@ -52,19 +180,53 @@ typedef struct wsky_Value_s {
 
 } wsky_Value;
 
+/** The lowest integer of a wsky_Value */
+# define wsky_Value_INT_MIN     INT64_MIN
 
-/** A predefined value for `true` */
-extern const wsky_Value wsky_Value_TRUE;
+/** The highest integer of a wsky_Value */
+# define wsky_Value_INT_MAX     INT64_MAX
 
-/** A predefined return value for `false` */
-extern const wsky_Value wsky_Value_FALSE;
+/** Initializes a constant wsky_Value from a boolean */
+# define wsky_Value_INIT_BOOL(b)                                 \
+  {.type = wsky_Type_BOOL, .v = {.boolValue = (b)}}
 
-/** A predefined return value for `null` */
-extern const wsky_Value wsky_Value_NULL;
+/** Initializes a constant wsky_Value from an integer */
+# define wsky_Value_INIT_INT(n)                                  \
+  {.type = wsky_Type_INT, .v = {.intValue = (n)}}
+
+/** Initializes the constant wsky_Value `null` */
+# define wsky_Value_INIT_NULL                                   \
+  {.type = wsky_Type_OBJECT, .v = {.objectValue = NULL}}
+
+/** Returns the type of a value */
+static inline wsky_Type wsky_Value_getType(wsky_Value value) {
+  return value.type;
+}
+
+/** Returns the boolean of a value of type wsky_Type_BOOL */
+static inline bool wsky_Value_getBool(wsky_Value value) {
+  return value.v.boolValue;
+}
+
+/** Returns the integer of a value of type wsky_Type_INT */
+static inline wsky_int wsky_Value_getInt(wsky_Value value) {
+  return value.v.intValue;
+}
+
+/** Returns the float of a value of type wsky_Type_FLOAT */
+static inline wsky_float wsky_Value_getFloat(wsky_Value value) {
+  return value.v.floatValue;
+}
+
+/** Returns the object of a value of type wsky_Type_OBJECT */
+static inline wsky_Object *wsky_Value_getObject(wsky_Value value) {
+  return value.v.objectValue;
+}
 
 /** Creates a new value from a boolean */
 static inline wsky_Value wsky_Value_fromBool(bool n) {
-  return n ? wsky_Value_TRUE : wsky_Value_FALSE;
+  wsky_Value v = wsky_Value_INIT_BOOL(n);
+  return v;
 }
 
 /** Creates a new value from a wsky_Object */
@@ -100,6 +262,18 @@ static inline wsky_Value wsky_Value_fromFloat(wsky_float n) {
   return v;
 }
 
+#endif /* WSKY_NAN_BOXING */
+
+
+/** A predefined value for `true` */
+extern const wsky_Value wsky_Value_TRUE;
+
+/** A predefined return value for `false` */
+extern const wsky_Value wsky_Value_FALSE;
+
+/** A predefined return value for `null` */
+extern const wsky_Value wsky_Value_NULL;
+
 /** Returns a wsky_Value or NULL */
 wsky_Value *wsky_Value_new(wsky_Value v);
 
@@ -108,7 +282,8 @@ wsky_Value *wsky_Value_new(wsky_Value v);
  * member objectValue is NULL
  */
 static inline bool wsky_isNull(const wsky_Value value) {
-  return value.type == wsky_Type_OBJECT && !value.v.objectValue;
+  return wsky_Value_getType(value) == wsky_Type_OBJECT &&
+    !wsky_Value_getObject(value);
 }
 
 /**
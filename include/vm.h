@@ -0,0 +1,36 @@
+#ifndef VM_H_
+# define VM_H_
+
+# include "code.h"
+# include "objects/scope.h"
+
+/**
+ * @defgroup vm vm
+ * The stack-based virtual machine which runs the bytecode.
+ * @{
+ */
+
+/**
+ * Runs a code in the given scope.
+ *
+ * The calls of functions written in Whiskey made by the code are run by
+ * the same C function, without recursion, unless the callee is compiled
+ * to machine code. The operand stacks are allocated with
+ * wsky_stack_allocate().
+ */
+wsky_ReturnValue wsky_vm_run(const wsky_Code *code, wsky_Scope *scope);
+
+/**
+ * Runs the body of a function in the scope of the call.
+ *
+ * The body is compiled on the first call, and the code is kept in the
+ * node.
+ */
+wsky_ReturnValue wsky_vm_runFunction(wsky_FunctionNode *node,
+                                     wsky_Scope *scope);
+
+/**
+ * @}
+ */
+
+#endif /* !VM_H_ */
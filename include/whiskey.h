@@ -11,22 +11,34 @@
 
 # include "ast.h"
 # include "class_def.h"
+# include "code.h"
+# include "compiler.h"
 # include "dict.h"
+# include "engine.h"
 # include "eval.h"
 # include "gc.h"
+# include "iterator.h"
+# include "jit.h"
 # include "keyword.h"
 # include "lexer.h"
 # include "memory.h"
 # include "method_def.h"
 # include "operator.h"
+# include "optimizer.h"
 # include "parser.h"
 # include "path.h"
 # include "position.h"
+# include "resolver.h"
 # include "return_value.h"
+# include "scope_layout.h"
+# include "selector.h"
+# include "shape.h"
+# include "stack.h"
 # include "string_reader.h"
 # include "string_utils.h"
 # include "syntax_error.h"
 # include "token.h"
+# include "vm.h"
 
 # include "objects/attribute_error.h"
 # include "objects/boolean.h"
@@ -66,9 +78,15 @@
 /** Returns true if Whiskey is started */
 bool wsky_isStarted(void);
 
-/** Starts Whiskey */
+/** Starts Whiskey with the AST engine */
 void wsky_start(void);
 
+/** Starts Whiskey with the given engine */
+void wsky_startWithEngine(wsky_Engine engine);
+
+/** Returns the engine given to wsky_startWithEngine() */
+wsky_Engine wsky_getEngine(void);
+
 /** Stops Whiskey */
 void wsky_stop(void);
 
@@ -25,6 +25,8 @@ D(ClassMember)
 D(Import)
 D(Export)
 D(If)
+D(While)
+D(For)
 
 #undef D
 
@@ -76,6 +78,8 @@ Node *wsky_ASTNode_copy(const Node *source) {
     CASE(IMPORT, Import);
     CASE(EXPORT, Export);
     CASE(IF, If);
+    CASE(WHILE, While);
+    CASE(FOR, For);
 
   default:
     return NULL;
@@ -133,6 +137,8 @@ char *wsky_ASTNode_toString(const Node *node) {
     CASE(IMPORT, Import);
     CASE(EXPORT, Export);
     CASE(IF, If);
+    CASE(WHILE, While);
+    CASE(FOR, For);
 
   default:
     return wsky_strdup("Unknown node");
@@ -181,7 +187,12 @@ void wsky_ASTNode_delete(Node *node) {
     R(Operator);
 
     CASE(SEQUENCE, Sequence);
-    CASE(FUNCTION, Function);
+
+  case wsky_ASTNodeType_FUNCTION:
+    if (--((FunctionNode *) node)->referenceCount > 0)
+      return;
+    R(Function);
+
     CASE(VAR, Var);
     CASE(ASSIGNMENT, Assignment);
     CASE(CALL, Call);
@@ -191,6 +202,8 @@ void wsky_ASTNode_delete(Node *node) {
     CASE(IMPORT, Import);
     CASE(EXPORT, Export);
     CASE(IF, If);
+    CASE(WHILE, While);
+    CASE(FOR, For);
 
   default:
     abort();
@@ -212,6 +225,7 @@ LiteralNode *wsky_LiteralNode_new(const Token *token) {
     return NULL;
 
   node->position = token->begin;
+  node->stringObject = wsky_GCRoot_EMPTY;
 
   if (token->type == wsky_TokenType_KEYWORD) {
     Keyword keyword = token->v.keyword;
@@ -249,7 +263,36 @@ LiteralNode *wsky_LiteralNode_new(const Token *token) {
   return node;
 }
 
+LiteralNode *wsky_LiteralNode_newFromValue(Position position, Value value) {
+  LiteralNode *node = wsky_safeMalloc(sizeof(LiteralNode));
+  node->position = position;
+  node->stringObject = wsky_GCRoot_EMPTY;
+
+  if (wsky_isNull(value)) {
+    node->type = wsky_ASTNodeType_NULL;
+  } else if (wsky_isBoolean(value)) {
+    node->type = wsky_ASTNodeType_BOOL;
+    node->v.boolValue = Value_getBool(value);
+  } else if (wsky_isInteger(value)) {
+    node->type = wsky_ASTNodeType_INT;
+    node->v.intValue = Value_getInt(value);
+  } else if (wsky_isFloat(value)) {
+    node->type = wsky_ASTNodeType_FLOAT;
+    node->v.floatValue = Value_getFloat(value);
+  } else if (wsky_isString(value)) {
+    node->type = wsky_ASTNodeType_STRING;
+    node->v.stringValue = wsky_strdup(
+      ((const String *)Value_getObject(value))->string);
+  } else {
+    wsky_free(node);
+    return NULL;
+  }
+
+  return node;
+}
+
 void LiteralNode_copy(const LiteralNode *source, LiteralNode *new) {
+  new->stringObject = wsky_GCRoot_EMPTY;
   if (source->type == wsky_ASTNodeType_STRING) {
     new->v.stringValue = wsky_strdup(source->v.stringValue);
   } else {
@@ -259,10 +302,22 @@ void LiteralNode_copy(const LiteralNode *source, LiteralNode *new) {
 
 static void LiteralNode_free(LiteralNode *node) {
   if (node->type == wsky_ASTNodeType_STRING) {
+    wsky_GC_removeRoot(&node->stringObject);
     wsky_free(node->v.stringValue);
   }
 }
 
+String *wsky_LiteralNode_getString(const LiteralNode *node) {
+  assert(node->type == wsky_ASTNodeType_STRING);
+  if (node->stringObject.object)
+    return (String *)node->stringObject.object;
+
+  String *string = wsky_String_new(node->v.stringValue);
+  /* The String is a cache, the node is not really modified */
+  wsky_GC_addRoot((GCRoot *)&node->stringObject, (Object *)string);
+  return string;
+}
+
 static char *stringNodeToString(const LiteralNode *node) {
   return wsky_String_escapeCString(node->v.stringValue);
 }
@@ -276,7 +331,7 @@ static char *floatNodeToString(const LiteralNode *node) {
   ReturnValue stringRv = wsky_toString(value);
   assert(!stringRv.exception);
   assert(wsky_isString(stringRv.v));
-  String *string = (String *)stringRv.v.v.objectValue;
+  String *string = (String *)Value_getObject(stringRv.v);
   return wsky_strdup(string->string);
 }
 
@@ -304,6 +359,7 @@ IdentifierNode *wsky_IdentifierNode_new(const char *name,
   node->type = type;
   node->position = position;
   node->name = name ? wsky_strdup(name) : NULL;
+  node->address = wsky_LexicalAddress_UNRESOLVED;
   return node;
 }
 
@@ -318,6 +374,7 @@ IdentifierNode *wsky_IdentifierNode_newFromToken(const Token *token) {
 
 void IdentifierNode_copy(const IdentifierNode *source, IdentifierNode *new) {
   new->name = source->name ? wsky_strdup(source->name) : NULL;
+  new->address = source->address;
 }
 
 static void IdentifierNode_free(IdentifierNode *node) {
@@ -411,6 +468,7 @@ OperatorNode *wsky_OperatorNode_new(const Token *token,
   node->left = left;
   node->operator = operator;
   node->right = right;
+  node->feedback = wsky_TypeFeedback_EMPTY;
   return node;
 }
 
@@ -426,11 +484,13 @@ OperatorNode *wsky_OperatorNode_newUnary(const Token *token,
   node->left = NULL;
   node->operator = operator;
   node->right = right;
+  node->feedback = wsky_TypeFeedback_EMPTY;
   return node;
 }
 
 void OperatorNode_copy(const OperatorNode *source, OperatorNode *new) {
   new->operator = source->operator;
+  new->feedback = wsky_TypeFeedback_EMPTY;
   new->right = wsky_ASTNode_copy(source->right);
   if (new->type == wsky_ASTNodeType_BINARY_OPERATOR) {
     new->left = wsky_ASTNode_copy(source->left);
@@ -555,15 +615,19 @@ SequenceNode *wsky_SequenceNode_new(const wsky_Position *position,
   node->children = children;
   node->position = *position;
   node->program = false;
+  node->layout = NULL;
   return node;
 }
 
 void SequenceNode_copy(const SequenceNode *source, SequenceNode *new) {
   new->children = wsky_ASTNodeList_copy(source->children);
+  new->program = source->program;
+  new->layout = wsky_ScopeLayout_retain(source->layout);
 }
 
 static void SequenceNode_free(SequenceNode *node) {
   wsky_ASTNodeList_delete(node->children);
+  wsky_ScopeLayout_release(node->layout);
 }
 
 static char *SequenceNode_toString(const SequenceNode *node) {
@@ -586,10 +650,20 @@ FunctionNode *wsky_FunctionNode_new(const Token *token,
   node->position = token->begin;
   node->children = children;
   node->parameters = parameters;
+  node->parameterCount = wsky_ASTNodeList_getCount(parameters);
   node->name = NULL;
+  node->layout = NULL;
+  node->code = NULL;
+  node->referenceCount = 1;
   return node;
 }
 
+FunctionNode *wsky_FunctionNode_retain(const FunctionNode *node) {
+  FunctionNode *shared = (FunctionNode *)node;
+  shared->referenceCount++;
+  return shared;
+}
+
 void wsky_FunctionNode_setName(wsky_FunctionNode *node,
                                const char *newName) {
   wsky_free(node->name);
@@ -600,12 +674,20 @@ void FunctionNode_copy(const FunctionNode *source, FunctionNode *new) {
   new->name = source->name ? wsky_strdup(source->name) : NULL;
   new->children = wsky_ASTNodeList_copy(source->children);
   new->parameters = wsky_ASTNodeList_copy(source->parameters);
+  new->parameterCount = source->parameterCount;
+  new->layout = wsky_ScopeLayout_retain(source->layout);
+
+  /* The code refers to the nodes of the source */
+  new->code = NULL;
+  new->referenceCount = 1;
 }
 
 static void FunctionNode_free(FunctionNode *node) {
   wsky_free(node->name);
   wsky_ASTNodeList_delete(node->children);
   wsky_ASTNodeList_delete(node->parameters);
+  wsky_ScopeLayout_release(node->layout);
+  wsky_Code_delete(node->code);
 }
 
 static char *FunctionNode_toString(const FunctionNode *node) {
@@ -632,13 +714,14 @@ VarNode *wsky_VarNode_new(const Token *token,
   node->position = token->begin;
   node->name = wsky_strdup(name);
   node->right = right;
+  node->address = wsky_LexicalAddress_UNRESOLVED;
   return node;
 }
 
 void VarNode_copy(const VarNode *source, VarNode *new) {
   new->name = wsky_strdup(source->name);
-  if (source->right)
-    new->right = wsky_ASTNode_copy(source->right);
+  new->right = source->right ? wsky_ASTNode_copy(source->right) : NULL;
+  new->address = source->address;
 }
 
 static void VarNode_free(VarNode *node) {
@@ -712,12 +795,16 @@ CallNode *wsky_CallNode_new(const Token *token,
   node->position = token->begin;
   node->left = left;
   node->children = children;
+  node->parameterCount = wsky_ASTNodeList_getCount(children);
+  node->tailCall = false;
   return node;
 }
 
 void CallNode_copy(const CallNode *source, CallNode *new) {
   new->left = wsky_ASTNode_copy(source->left);
   new->children = wsky_ASTNodeList_copy(source->children);
+  new->parameterCount = source->parameterCount;
+  new->tailCall = source->tailCall;
 }
 
 static void CallNode_free(CallNode *node) {
@@ -744,6 +831,9 @@ MemberAccessNode *wsky_MemberAccessNode_new(const Token *token,
   node->position = token->begin;
   node->left = left;
   node->name = wsky_strdup(name);
+  node->selector = -1;
+  node->fieldSlot = -1;
+  node->shapeCache = wsky_ShapeCache_EMPTY;
   return node;
 }
 
@@ -751,6 +841,9 @@ void MemberAccessNode_copy(const MemberAccessNode *source,
                            MemberAccessNode *new) {
   new->left = wsky_ASTNode_copy(source->left);
   new->name = wsky_strdup(source->name);
+  new->selector = source->selector;
+  new->fieldSlot = source->fieldSlot;
+  new->shapeCache = wsky_ShapeCache_EMPTY;
 }
 
 static void MemberAccessNode_free(MemberAccessNode *node) {
@@ -780,6 +873,7 @@ ClassNode *wsky_ClassNode_new(const Token *token,
   node->superclass = superclass;
   node->interfaces = interfaces;
   node->children = children;
+  node->fields = NULL;
   return node;
 }
 
@@ -789,6 +883,7 @@ void ClassNode_copy(const ClassNode *source, ClassNode *new) {
     wsky_ASTNode_copy(source->superclass) : NULL;
   new->interfaces = wsky_ASTNodeList_copy(source->interfaces);
   new->children = wsky_ASTNodeList_copy(source->children);
+  new->fields = wsky_ScopeLayout_retain(source->fields);
 }
 
 static void ClassNode_free(ClassNode *node) {
@@ -797,6 +892,7 @@ static void ClassNode_free(ClassNode *node) {
     wsky_ASTNode_delete(node->superclass);
   wsky_ASTNodeList_delete(node->children);
   wsky_ASTNodeList_delete(node->interfaces);
+  wsky_ScopeLayout_release(node->fields);
 }
 
 static char *superclassesToString(const ClassNode *node) {
@@ -867,7 +963,7 @@ ClassMemberNode *wsky_ClassMemberNode_new(const Token *token,
 void ClassMemberNode_copy(const ClassMemberNode *source,
                           ClassMemberNode *new) {
   new->name = source->name ? wsky_strdup(source->name) : NULL;
-  new->right = wsky_ASTNode_copy((Node *)new);
+  new->right = source->right ? wsky_ASTNode_copy(source->right) : NULL;
   new->flags = source->flags;
 }
 
@@ -1043,3 +1139,77 @@ static char *IfNode_toString(const IfNode *node) {
 
   return s;
 }
+
+
+
+WhileNode *wsky_WhileNode_new(Position position, Node *test, Node *body) {
+  assert(test);
+  assert(body);
+  WhileNode *node = wsky_safeMalloc(sizeof(WhileNode));
+  node->type = wsky_ASTNodeType_WHILE;
+  node->position = position;
+  node->test = test;
+  node->body = body;
+  node->layout = NULL;
+  return node;
+}
+
+static void WhileNode_copy(const WhileNode *source, WhileNode *new) {
+  new->test = wsky_ASTNode_copy(source->test);
+  new->body = wsky_ASTNode_copy(source->body);
+  new->layout = wsky_ScopeLayout_retain(source->layout);
+}
+
+static void WhileNode_free(WhileNode *node) {
+  wsky_ASTNode_delete(node->test);
+  wsky_ASTNode_delete(node->body);
+  wsky_ScopeLayout_release(node->layout);
+}
+
+static char *WhileNode_toString(const WhileNode *node) {
+  char *test = wsky_ASTNode_toString(node->test);
+  char *body = wsky_ASTNode_toString(node->body);
+  char *s = wsky_asprintf("while %s: %s", test, body);
+  wsky_free(test);
+  wsky_free(body);
+  return s;
+}
+
+
+
+ForNode *wsky_ForNode_new(Position position, const char *name,
+                          Node *iterable, Node *body) {
+  assert(iterable);
+  assert(body);
+  ForNode *node = wsky_safeMalloc(sizeof(ForNode));
+  node->type = wsky_ASTNodeType_FOR;
+  node->position = position;
+  node->name = wsky_strdup(name);
+  node->iterable = iterable;
+  node->body = body;
+  node->layout = NULL;
+  return node;
+}
+
+static void ForNode_copy(const ForNode *source, ForNode *new) {
+  new->name = wsky_strdup(source->name);
+  new->iterable = wsky_ASTNode_copy(source->iterable);
+  new->body = wsky_ASTNode_copy(source->body);
+  new->layout = wsky_ScopeLayout_retain(source->layout);
+}
+
+static void ForNode_free(ForNode *node) {
+  wsky_free(node->name);
+  wsky_ASTNode_delete(node->iterable);
+  wsky_ASTNode_delete(node->body);
+  wsky_ScopeLayout_release(node->layout);
+}
+
+static char *ForNode_toString(const ForNode *node) {
+  char *iterable = wsky_ASTNode_toString(node->iterable);
+  char *body = wsky_ASTNode_toString(node->body);
+  char *s = wsky_asprintf("for %s in %s: %s", node->name, iterable, body);
+  wsky_free(iterable);
+  wsky_free(body);
+  return s;
+}
@@ -47,6 +47,13 @@ static const ClassInfo BUILTIN_CLASSES[] = {
 };
 
 
+#define BUILTIN_CLASSES_COUNT                                   \
+  (sizeof(BUILTIN_CLASSES) / sizeof(ClassInfo) - 1)
+
+/** The static method tables of the builtin classes */
+static BuiltinMethodTable builtinTables[BUILTIN_CLASSES_COUNT];
+
+
 static ClassArray builtinsClassArray = {NULL, 0};
 
 
@@ -57,6 +64,69 @@ static size_t getBuiltinClassesCount(void) {
   return count;
 }
 
+
+
+/** An entry of the perfect hash table of the builtins */
+typedef struct {
+  /** The name or NULL if the entry is empty */
+  const char *name;
+
+  Value value;
+} Builtin;
+
+static struct {
+  Builtin *entries;
+
+  /** A power of two */
+  size_t size;
+} builtins = {NULL, 0};
+
+
+/*
+ * Tries to store the builtins in a table of the given size, with no
+ * collision.
+ */
+static bool fillBuiltins(size_t size) {
+  builtins.entries = wsky_safeMalloc(size * sizeof(Builtin));
+  builtins.size = size;
+  for (size_t i = 0; i < size; i++)
+    builtins.entries[i].name = NULL;
+
+  for (const ClassInfo *info = BUILTIN_CLASSES; info->def; info++) {
+    Class *class = *info->classPointer;
+    uint32_t hash = wsky_hashString(class->name);
+    Builtin *entry = builtins.entries + (hash & (size - 1));
+    if (entry->name) {
+      wsky_free(builtins.entries);
+      builtins.entries = NULL;
+      return false;
+    }
+    entry->name = class->name;
+    entry->value = Value_fromObject((Object *)class);
+  }
+  return true;
+}
+
+static void initBuiltins(void) {
+  size_t size = 1;
+  while (size < 2 * getBuiltinClassesCount())
+    size *= 2;
+  while (!fillBuiltins(size)) {
+    size *= 2;
+    if (size > 1 << 16)
+      abort();
+  }
+}
+
+const Value *wsky_getBuiltin(const char *name) {
+  const Builtin *entry;
+  entry = builtins.entries + (wsky_hashString(name) & (builtins.size - 1));
+  if (!entry->name || strcmp(entry->name, name) != 0)
+    return NULL;
+  return &entry->value;
+}
+
+
 static void initBuiltinsClassArray(void) {
   size_t count = getBuiltinClassesCount();
   builtinsClassArray.count = count;
@@ -102,7 +172,8 @@ static Class* getSuperClass(const ClassDef *def) {
 static void initClass(const ClassInfo *info) {
   const ClassDef *def = info->def;
   Class **classPointer = info->classPointer;
-  *classPointer = wsky_Class_newFromC(def, getSuperClass(def));
+  BuiltinMethodTable *table = builtinTables + (info - BUILTIN_CLASSES);
+  *classPointer = wsky_Class_newFromC(def, getSuperClass(def), table);
 
   if (def == &wsky_Object_CLASS_DEF) {
     wsky_Object_CLASS->class = wsky_Class_CLASS;
@@ -130,10 +201,20 @@ void wsky_initBuiltinClasses(void) {
   wsky_Class_initMethods(wsky_Function_CLASS, &wsky_Function_CLASS_DEF);
   wsky_Class_initMethods(wsky_Method_CLASS, &wsky_Method_CLASS_DEF);
 
+  classInfo = BUILTIN_CLASSES;
+  while (classInfo->def) {
+    wsky_Class_finalize(*classInfo->classPointer);
+    classInfo++;
+  }
+
   initBuiltinsClassArray();
+  initBuiltins();
 }
 
 void wsky_freeBuiltinClasses(void) {
+  wsky_free(builtins.entries);
+  builtins.entries = NULL;
+  builtins.size = 0;
 
   free(builtinsClassArray.classes);
 }
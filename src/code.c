@@ -0,0 +1,107 @@
+#include <assert.h>
+#include <string.h>
+#include "whiskey_private.h"
+
+
+const char *wsky_Opcode_toString(Opcode opcode) {
+#define CASE(name) case wsky_Opcode_ ## name: return #name
+  switch (opcode) {
+    CASE(PUSH_NULL);
+    CASE(PUSH_TRUE);
+    CASE(PUSH_FALSE);
+    CASE(PUSH_CONSTANT);
+    CASE(PUSH_STRING);
+    CASE(LOAD_VARIABLE);
+    CASE(DECLARE_VARIABLE);
+    CASE(STORE_VARIABLE);
+    CASE(POP);
+    CASE(BINARY_OPERATOR);
+    CASE(UNARY_OPERATOR);
+    CASE(CALL);
+    CASE(TAIL_CALL);
+    CASE(GET_METHOD);
+    CASE(CALL_METHOD);
+    CASE(TAIL_CALL_METHOD);
+    CASE(GET_MEMBER);
+    CASE(SET_MEMBER);
+    CASE(MAKE_FUNCTION);
+    CASE(JUMP);
+    CASE(JUMP_IF_FALSE);
+    CASE(ENTER_SCOPE);
+    CASE(LEAVE_SCOPE);
+    CASE(ENTER_LOOP);
+    CASE(NEXT_ITERATION);
+    CASE(ITERATE);
+    CASE(FOR_NEXT);
+    CASE(EVAL_NODE);
+    CASE(RETURN);
+  }
+#undef CASE
+  abort();
+}
+
+
+
+Code *wsky_Code_new(void) {
+  Code *code = wsky_safeMalloc(sizeof(Code));
+  memset(code, 0, sizeof(Code));
+  return code;
+}
+
+void wsky_Code_delete(Code *code) {
+  if (!code)
+    return;
+  wsky_jit_free(code);
+  wsky_free(code->instructions);
+  wsky_free(code->constants);
+  wsky_free(code->nodes);
+  wsky_free(code);
+}
+
+
+static void *growArray(void *array, unsigned *capacity, size_t itemSize) {
+  *capacity = *capacity ? *capacity * 2 : 16;
+  array = wsky_realloc(array, *capacity * itemSize);
+  if (!array)
+    abort();
+  return array;
+}
+
+unsigned wsky_Code_addInstruction(Code *code, Opcode opcode, int operand) {
+  if (code->instructionCount + 2 > code->instructionCapacity)
+    code->instructions = growArray(code->instructions,
+                                   &code->instructionCapacity,
+                                   sizeof(int));
+  unsigned index = code->instructionCount;
+  code->instructions[index] = (int)opcode;
+  code->instructions[index + 1] = operand;
+  code->instructionCount += 2;
+  return index;
+}
+
+int wsky_Code_addConstant(Code *code, Value value) {
+  if (code->constantCount == code->constantCapacity)
+    code->constants = growArray(code->constants,
+                                &code->constantCapacity,
+                                sizeof(Value));
+  code->constants[code->constantCount] = value;
+  return (int)code->constantCount++;
+}
+
+int wsky_Code_addNode(Code *code, const Node *node) {
+  if (code->nodeCount == code->nodeCapacity)
+    code->nodes = growArray(code->nodes,
+                            &code->nodeCapacity,
+                            sizeof(Node *));
+  code->nodes[code->nodeCount] = node;
+  return (int)code->nodeCount++;
+}
+
+
+void wsky_Code_print(const Code *code, FILE *output) {
+  for (unsigned i = 0; i < code->instructionCount; i += 2) {
+    Opcode opcode = (Opcode)code->instructions[i];
+    fprintf(output, "%4u %-16s %d\n", i,
+            wsky_Opcode_toString(opcode), code->instructions[i + 1]);
+  }
+}
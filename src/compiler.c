@@ -0,0 +1,335 @@
+#include <assert.h>
+#include "whiskey_private.h"
+
+
+typedef struct {
+  Code *code;
+
+  /** The number of values on the stack at the current instruction */
+  unsigned stackSize;
+} Compiler;
+
+
+static void compileNode(Compiler *c, const Node *node);
+
+
+static void growStack(Compiler *c, int delta) {
+  assert(delta >= 0 || c->stackSize >= (unsigned)-delta);
+  c->stackSize += delta;
+  if (c->stackSize > c->code->maxStackSize)
+    c->code->maxStackSize = c->stackSize;
+}
+
+static unsigned emit(Compiler *c, Opcode opcode, int operand,
+                     int stackDelta) {
+  growStack(c, stackDelta);
+  return wsky_Code_addInstruction(c->code, opcode, operand);
+}
+
+static unsigned emitNode(Compiler *c, Opcode opcode, const Node *node,
+                         int stackDelta) {
+  return emit(c, opcode, wsky_Code_addNode(c->code, node), stackDelta);
+}
+
+/** Sets the operand of a jump to the next instruction */
+static void patchJump(Compiler *c, unsigned jump) {
+  c->code->instructions[jump + 1] = (int)c->code->instructionCount;
+}
+
+
+
+static void compileChildren(Compiler *c, const NodeList *child) {
+  if (!child) {
+    emit(c, wsky_Opcode_PUSH_NULL, 0, 1);
+    return;
+  }
+  while (child) {
+    compileNode(c, child->node);
+    child = child->next;
+    if (child)
+      emit(c, wsky_Opcode_POP, 0, -1);
+  }
+}
+
+static void compileSequence(Compiler *c, const SequenceNode *node) {
+  emitNode(c, wsky_Opcode_ENTER_SCOPE, (const Node *)node, 0);
+  compileChildren(c, node->children);
+  emit(c, wsky_Opcode_LEAVE_SCOPE, 0, 0);
+}
+
+static void compileLiteral(Compiler *c, const LiteralNode *node) {
+  switch (node->type) {
+  case wsky_ASTNodeType_NULL:
+    emit(c, wsky_Opcode_PUSH_NULL, 0, 1);
+    break;
+
+  case wsky_ASTNodeType_BOOL:
+    emit(c, node->v.boolValue ? wsky_Opcode_PUSH_TRUE : wsky_Opcode_PUSH_FALSE,
+         0, 1);
+    break;
+
+  case wsky_ASTNodeType_INT:
+    emit(c, wsky_Opcode_PUSH_CONSTANT,
+         wsky_Code_addConstant(c->code, Value_fromInt(node->v.intValue)), 1);
+    break;
+
+  case wsky_ASTNodeType_FLOAT:
+    emit(c, wsky_Opcode_PUSH_CONSTANT,
+         wsky_Code_addConstant(c->code,
+                               Value_fromFloat(node->v.floatValue)), 1);
+    break;
+
+  default:
+    emitNode(c, wsky_Opcode_PUSH_STRING, (const Node *)node, 1);
+  }
+}
+
+static void compileOperator(Compiler *c, const OperatorNode *node) {
+  if (node->left) {
+    compileNode(c, node->left);
+    compileNode(c, node->right);
+    emitNode(c, wsky_Opcode_BINARY_OPERATOR, (const Node *)node, -1);
+  } else {
+    compileNode(c, node->right);
+    emit(c, wsky_Opcode_UNARY_OPERATOR, (int)node->operator, 0);
+  }
+}
+
+static void compileVar(Compiler *c, const VarNode *node) {
+  if (node->right)
+    compileNode(c, node->right);
+  else
+    emit(c, wsky_Opcode_PUSH_NULL, 0, 1);
+  emitNode(c, wsky_Opcode_DECLARE_VARIABLE, (const Node *)node, 0);
+}
+
+static void compileAssignment(Compiler *c, const AssignmentNode *node) {
+  const Node *left = node->left;
+
+  if (left->type == wsky_ASTNodeType_IDENTIFIER) {
+    compileNode(c, node->right);
+    emitNode(c, wsky_Opcode_STORE_VARIABLE, left, 0);
+    return;
+  }
+
+  if (left->type == wsky_ASTNodeType_MEMBER_ACCESS) {
+    const MemberAccessNode *member = (const MemberAccessNode *)left;
+    if (member->left->type != wsky_ASTNodeType_SUPER) {
+      compileNode(c, node->right);
+      compileNode(c, member->left);
+      emitNode(c, wsky_Opcode_SET_MEMBER, left, -1);
+      return;
+    }
+  }
+
+  emitNode(c, wsky_Opcode_EVAL_NODE, (const Node *)node, 1);
+}
+
+static void compileCall(Compiler *c, const CallNode *node) {
+  unsigned parameterCount = node->parameterCount;
+  if (node->left->type == wsky_ASTNodeType_SUPER) {
+    emitNode(c, wsky_Opcode_EVAL_NODE, (const Node *)node, 1);
+    return;
+  }
+
+  const Node *left = node->left;
+  const MemberAccessNode *member = NULL;
+  if (left->type == wsky_ASTNodeType_MEMBER_ACCESS &&
+      ((const MemberAccessNode *)left)->left->type != wsky_ASTNodeType_SUPER)
+    member = (const MemberAccessNode *)left;
+
+  if (member) {
+    compileNode(c, member->left);
+    emitNode(c, wsky_Opcode_GET_METHOD, left, 1);
+  } else {
+    compileNode(c, left);
+  }
+
+  const NodeList *child = node->children;
+  while (child) {
+    compileNode(c, child->node);
+    child = child->next;
+  }
+
+  if (member && node->tailCall)
+    emit(c, wsky_Opcode_TAIL_CALL_METHOD,
+         (int)parameterCount, -(int)parameterCount - 1);
+  else if (member)
+    emit(c, wsky_Opcode_CALL_METHOD,
+         (int)parameterCount, -(int)parameterCount - 1);
+  else
+    emit(c, node->tailCall ? wsky_Opcode_TAIL_CALL : wsky_Opcode_CALL,
+         (int)parameterCount, -(int)parameterCount);
+}
+
+static void compileMemberAccess(Compiler *c, const MemberAccessNode *node) {
+  if (node->left->type == wsky_ASTNodeType_SUPER) {
+    emitNode(c, wsky_Opcode_EVAL_NODE, (const Node *)node, 1);
+    return;
+  }
+  compileNode(c, node->left);
+  emitNode(c, wsky_Opcode_GET_MEMBER, (const Node *)node, 0);
+}
+
+static void compileIf(Compiler *c, const IfNode *node) {
+  const NodeList *tests = node->tests;
+  const NodeList *expressions = node->expressions;
+
+  /* The jumps to the end are chained through their operands */
+  int endJumps = -1;
+
+  while (tests) {
+    assert(expressions);
+
+    compileNode(c, tests->node);
+    unsigned nextTest = emit(c, wsky_Opcode_JUMP_IF_FALSE, 0, -1);
+    compileNode(c, expressions->node);
+    endJumps = (int)emit(c, wsky_Opcode_JUMP, endJumps, 0);
+    patchJump(c, nextTest);
+
+    /* Only one of the branches is run */
+    growStack(c, -1);
+
+    expressions = expressions->next;
+    tests = tests->next;
+  }
+
+  if (node->elseNode)
+    compileNode(c, node->elseNode);
+  else
+    emit(c, wsky_Opcode_PUSH_NULL, 0, 1);
+
+  while (endJumps >= 0) {
+    int next = c->code->instructions[endJumps + 1];
+    patchJump(c, (unsigned)endJumps);
+    endJumps = next;
+  }
+}
+
+static void compileLoopBody(Compiler *c, const LoopNode *node) {
+  if (node->body->type == wsky_ASTNodeType_SEQUENCE)
+    compileChildren(c, ((const SequenceNode *)node->body)->children);
+  else
+    compileNode(c, node->body);
+  emit(c, wsky_Opcode_POP, 0, -1);
+  emitNode(c, wsky_Opcode_NEXT_ITERATION, (const Node *)node, 0);
+}
+
+static void compileWhile(Compiler *c, const WhileNode *node) {
+  emitNode(c, wsky_Opcode_ENTER_LOOP, (const Node *)node, 0);
+  unsigned start = c->code->instructionCount;
+  compileNode(c, node->test);
+  unsigned end = emit(c, wsky_Opcode_JUMP_IF_FALSE, 0, -1);
+  compileLoopBody(c, (const LoopNode *)node);
+  emit(c, wsky_Opcode_JUMP, (int)start, 0);
+  patchJump(c, end);
+  emit(c, wsky_Opcode_LEAVE_SCOPE, 0, 0);
+  emit(c, wsky_Opcode_PUSH_NULL, 0, 1);
+}
+
+/*
+ * The iterator stays on the stack during the loop, so the iterations
+ * allocate nothing.
+ */
+static void compileFor(Compiler *c, const ForNode *node) {
+  compileNode(c, node->iterable);
+  emit(c, wsky_Opcode_ITERATE, 0, 1);
+  emitNode(c, wsky_Opcode_ENTER_LOOP, (const Node *)node, 0);
+  unsigned start = emitNode(c, wsky_Opcode_FOR_NEXT, (const Node *)node, 1);
+  unsigned end = emit(c, wsky_Opcode_JUMP_IF_FALSE, 0, -1);
+  compileLoopBody(c, (const LoopNode *)node);
+  emit(c, wsky_Opcode_JUMP, (int)start, 0);
+  patchJump(c, end);
+  emit(c, wsky_Opcode_LEAVE_SCOPE, 0, 0);
+  emit(c, wsky_Opcode_POP, 0, -1);
+  emit(c, wsky_Opcode_POP, 0, -1);
+  emit(c, wsky_Opcode_PUSH_NULL, 0, 1);
+}
+
+static void compileNode(Compiler *c, const Node *node) {
+#define CASE(type) case wsky_ASTNodeType_ ## type
+  switch (node->type) {
+  CASE(NULL):
+  CASE(BOOL):
+  CASE(INT):
+  CASE(FLOAT):
+  CASE(STRING):
+    compileLiteral(c, (const LiteralNode *)node);
+    break;
+
+  CASE(SEQUENCE):
+    compileSequence(c, (const SequenceNode *)node);
+    break;
+
+  CASE(UNARY_OPERATOR):
+  CASE(BINARY_OPERATOR):
+    compileOperator(c, (const OperatorNode *)node);
+    break;
+
+  CASE(VAR):
+    compileVar(c, (const VarNode *)node);
+    break;
+
+  CASE(IDENTIFIER):
+    emitNode(c, wsky_Opcode_LOAD_VARIABLE, node, 1);
+    break;
+
+  CASE(ASSIGNMENT):
+    compileAssignment(c, (const AssignmentNode *)node);
+    break;
+
+  CASE(FUNCTION):
+    emitNode(c, wsky_Opcode_MAKE_FUNCTION, node, 1);
+    break;
+
+  CASE(CALL):
+    compileCall(c, (const CallNode *)node);
+    break;
+
+  CASE(MEMBER_ACCESS):
+    compileMemberAccess(c, (const MemberAccessNode *)node);
+    break;
+
+  CASE(IF):
+    compileIf(c, (const IfNode *)node);
+    break;
+
+  CASE(WHILE):
+    compileWhile(c, (const WhileNode *)node);
+    break;
+
+  CASE(FOR):
+    compileFor(c, (const ForNode *)node);
+    break;
+
+  default:
+    emitNode(c, wsky_Opcode_EVAL_NODE, node, 1);
+  }
+#undef CASE
+}
+
+
+
+static Code *finish(Compiler *c) {
+  emit(c, wsky_Opcode_RETURN, 0, -1);
+  assert(c->stackSize == 0);
+  return c->code;
+}
+
+Code *wsky_compile(const Node *node) {
+  Compiler c = {wsky_Code_new(), 0};
+  compileNode(&c, node);
+  return finish(&c);
+}
+
+Code *wsky_compileSequence(const SequenceNode *node) {
+  Compiler c = {wsky_Code_new(), 0};
+  compileChildren(&c, node->children);
+  return finish(&c);
+}
+
+Code *wsky_compileFunction(const FunctionNode *node) {
+  Compiler c = {wsky_Code_new(), 0};
+  compileChildren(&c, node->children);
+  return finish(&c);
+}
@@ -58,6 +58,18 @@ void wsky_Dict_applyConst(const Dict *self,
   }
 }
 
+void wsky_Dict_applyWithData(const Dict *self,
+                             void (*function)(const char *key, void *value,
+                                              void *data),
+                             void *data) {
+
+  Entry *entry = self->first;
+  while (entry) {
+    function(entry->key, entry->value, data);
+    entry = entry->next;
+  }
+}
+
 
 static Entry *getEntry(const Dict *self, const char *key) {
   Entry *entry = self->first;
@@ -53,7 +53,7 @@ Scope *wsky_eval_popScope(void) {
 
 void wsky_eval_visitScopeStack(void) {
   for (size_t i = 0; i < scopeStack.length; i++)
-    wsky_GC_visitObject(scopeStack.scopes[i]);
+    wsky_Scope_visit(scopeStack.scopes[i]);
 }
 
 
@@ -68,13 +68,7 @@ void wsky_eval_visitScopeStack(void) {
 static ReturnValue createUnsupportedBinOpError(const char *leftClass,
                                                const char *operator,
                                                Value right) {
-  char *message = wsky_asprintf("Unsupported classes for %s: %s and %s",
-                                operator,
-                                leftClass,
-                                wsky_getClassName(right));
-  Exception *e = (Exception *)wsky_TypeError_new(message);
-  free(message);
-  RAISE_EXCEPTION(e);
+  return wsky_TypeError_raiseUnsupportedOperands(leftClass, operator, right);
 }
 
 static ReturnValue createUnsupportedUnaryOpError(const char *operator,
@@ -89,7 +83,9 @@ static ReturnValue createUnsupportedUnaryOpError(const char *operator,
 
 
 /*
- * Returns a new `NotImplementedException`
+ * Returns a new `NotImplementedException`, used by the unary operators.
+ * The binary operators use `RETURN_NOT_IMPLEMENTED`, which does not
+ * allocate anything.
  */
 #define RETURN_NOT_IMPL(operator)               \
   RAISE_NEW_NOT_IMPLEMENTED_ERROR(operator)
@@ -103,39 +99,80 @@ static ReturnValue createUnsupportedUnaryOpError(const char *operator,
   ((e) && (e)->class == wsky_NotImplementedError_CLASS)
 
 
+/*
+ * An Integer operation whose result does not fit in a wsky_Value gives
+ * a Float, with both representations of the values. The overflow is
+ * tested before the operation, which never overflows in C.
+ */
+
+#define INT_MIN_ wsky_Value_INT_MIN
+#define INT_MAX_ wsky_Value_INT_MAX
+
+static inline ReturnValue intSum(wsky_int left, wsky_int right) {
+  if (right > 0 ? left > INT_MAX_ - right : left < INT_MIN_ - right)
+    RETURN_FLOAT((wsky_float)left + (wsky_float)right);
+  RETURN_INT(left + right);
+}
+
+static inline ReturnValue intDifference(wsky_int left, wsky_int right) {
+  if (right < 0 ? left > INT_MAX_ + right : left < INT_MIN_ + right)
+    RETURN_FLOAT((wsky_float)left - (wsky_float)right);
+  RETURN_INT(left - right);
+}
+
+static inline ReturnValue intProduct(wsky_int left, wsky_int right) {
+  bool overflow;
+  if (left == 0 || right == 0)
+    overflow = false;
+  else if (left > 0)
+    overflow = right > 0 ? left > INT_MAX_ / right : right < INT_MIN_ / left;
+  else
+    overflow = right > 0 ? left < INT_MIN_ / right : left < INT_MAX_ / right;
+
+  if (overflow)
+    RETURN_FLOAT((wsky_float)left * (wsky_float)right);
+  RETURN_INT(left * right);
+}
+
+/* The divisor must not be 0 */
+static inline ReturnValue intQuotient(wsky_int left, wsky_int right) {
+  if (left == INT_MIN_ && right == -1)
+    RETURN_FLOAT(-(wsky_float)left);
+  RETURN_INT(left / right);
+}
+
+static inline ReturnValue intNegation(wsky_int right) {
+  if (right == INT_MIN_)
+    RETURN_FLOAT(-(wsky_float)right);
+  RETURN_INT(-right);
+}
+
+#undef INT_MIN_
+#undef INT_MAX_
+
+
 #include "eval_int.c"
 #include "eval_float.c"
 #include "eval_bool.c"
 
 
-static const char *getBinOperatorMethodName(Operator operator,
-                                            bool right) {
-  static char buffer[64];
-  snprintf(buffer, 63, "operator %s%s",
-           right ? "r" : "",
-           wsky_Operator_toString(operator));
-  return buffer;
-}
-
 static ReturnValue evalBinOperatorValues(Value left,
                                          Operator operator,
                                          Value right,
                                          bool reverse) {
-  switch (left.type) {
+  switch (Value_getType(left)) {
   case Type_BOOL:
-    return evalBinOperatorBool(left.v.boolValue, operator, right);
+    return evalBinOperatorBool(Value_getBool(left), operator, right);
 
   case Type_INT:
-    return evalBinOperatorInt(left.v.intValue, operator, right);
+    return evalBinOperatorInt(Value_getInt(left), operator, right);
 
   case Type_FLOAT:
-    return evalBinOperatorFloat(left.v.floatValue, operator, right);
+    return evalBinOperatorFloat(Value_getFloat(left), operator, right);
 
-  case Type_OBJECT: {
-    const char *method = getBinOperatorMethodName(operator, reverse);
-    Object *object = left.v.objectValue;
-    return wsky_Object_callMethod1(object, method, right);
-  }
+  case Type_OBJECT:
+    return wsky_Object_callBinaryOperator(Value_getObject(left),
+                                          operator, reverse, right);
   }
   abort();
 }
@@ -144,20 +181,26 @@ static ReturnValue evalBinOperatorValues(Value left,
 static ReturnValue evalUnaryOperatorValues(Operator operator,
                                            Value right) {
 
-  switch (right.type) {
+  switch (Value_getType(right)) {
   case Type_BOOL:
-    return evalUnaryOperatorBool(operator, right.v.boolValue);
+    return evalUnaryOperatorBool(operator, Value_getBool(right));
 
   case Type_INT:
-    return evalUnaryOperatorInt(operator, right.v.intValue);
+    return evalUnaryOperatorInt(operator, Value_getInt(right));
 
   case Type_FLOAT:
-    return evalUnaryOperatorFloat(operator, right.v.floatValue);
+    return evalUnaryOperatorFloat(operator, Value_getFloat(right));
 
-  default:
+  case Type_OBJECT:
     return createUnsupportedUnaryOpError(wsky_Operator_toString(operator),
                                          wsky_getClassName(right));
   }
+  abort();
+}
+
+
+ReturnValue wsky_doUnaryOperation(Operator operator, Value right) {
+  return evalUnaryOperatorValues(operator, right);
 }
 
 
@@ -188,19 +231,187 @@ ReturnValue wsky_doBinaryOperation(Value left,
 }
 
 
-static ReturnValue evalBinOperator(const Node *leftNode,
-                                   Operator operator,
-                                   const Node *rightNode,
-                                   Scope *scope) {
-  ReturnValue leftRV = wsky_evalNode(leftNode, scope);
+
+/*
+ * Quickening
+ *
+ * A binary operator node counts the operand types it sees. After
+ * QUICKENING_THRESHOLD executions in a row with two ints, two floats or
+ * two strings, it specializes itself: the next executions check the
+ * types (the guard) and run the operation inline. A guard miss brings
+ * the node back to the generic path. After MAX_DESPECIALIZATIONS
+ * misses the node stays generic.
+ */
+
+#define QUICKENING_THRESHOLD 8
+
+#define MAX_DESPECIALIZATIONS 4
+
+#define wsky_QUICKENING_LOGGING 0
+
+static const char *getOperandTypesName(OperandTypes types) {
+  switch (types) {
+  case wsky_OperandTypes_GENERIC: return "generic";
+  case wsky_OperandTypes_INT: return "int";
+  case wsky_OperandTypes_FLOAT: return "float";
+  case wsky_OperandTypes_STRING: return "string";
+  }
+  abort();
+}
+
+#if wsky_QUICKENING_LOGGING == 1
+static void quickeningLog(const OperatorNode *node, const char *event) {
+  const TypeFeedback *f = &node->feedback;
+  fprintf(stderr,
+          "quickening: %s %s at %d:%d (%s), %u hits, %u misses\n",
+          event, wsky_Operator_toString(node->operator),
+          node->position.line, node->position.column,
+          getOperandTypesName(f->specialization), f->hits, f->misses);
+}
+#else
+static inline void quickeningLog(const OperatorNode *node,
+                                 const char *event) {
+  (void)node;
+  (void)event;
+  (void)getOperandTypesName;
+}
+#endif
+
+static OperandTypes getOperandTypes(Value left, Value right) {
+  if (isInt(left) && isInt(right))
+    return wsky_OperandTypes_INT;
+  if (isFloat(left) && isFloat(right))
+    return wsky_OperandTypes_FLOAT;
+  if (wsky_isString(left) && wsky_isString(right))
+    return wsky_OperandTypes_STRING;
+  return wsky_OperandTypes_GENERIC;
+}
+
+static void observeOperandTypes(OperatorNode *node, OperandTypes types) {
+  TypeFeedback *f = &node->feedback;
+  if (types != f->observed) {
+    f->observed = types;
+    f->observedCount = 0;
+  }
+  f->observedCount++;
+
+  if (types != wsky_OperandTypes_GENERIC &&
+      f->observedCount >= QUICKENING_THRESHOLD &&
+      f->misses < MAX_DESPECIALIZATIONS) {
+    f->specialization = types;
+    quickeningLog(node, "specialize");
+  }
+}
+
+static void despecialize(OperatorNode *node) {
+  TypeFeedback *f = &node->feedback;
+  f->misses++;
+  quickeningLog(node, "despecialize");
+  f->specialization = wsky_OperandTypes_GENERIC;
+  f->observed = wsky_OperandTypes_GENERIC;
+  f->observedCount = 0;
+}
+
+static ReturnValue evalQuickenedInt(wsky_int left, Operator operator,
+                                    wsky_int right) {
+  switch (operator) {
+  case wsky_Operator_PLUS: return intSum(left, right);
+  case wsky_Operator_MINUS: return intDifference(left, right);
+  case wsky_Operator_STAR: return intProduct(left, right);
+  case wsky_Operator_LT: RETURN_BOOL(left < right);
+  case wsky_Operator_LT_EQ: RETURN_BOOL(left <= right);
+  case wsky_Operator_GT: RETURN_BOOL(left > right);
+  case wsky_Operator_GT_EQ: RETURN_BOOL(left >= right);
+  case wsky_Operator_EQUALS: RETURN_BOOL(left == right);
+  case wsky_Operator_NOT_EQUALS: RETURN_BOOL(left != right);
+  default:
+    return wsky_doBinaryOperation(Value_fromInt(left), operator,
+                                  Value_fromInt(right));
+  }
+}
+
+static ReturnValue evalQuickenedFloat(wsky_float left, Operator operator,
+                                      wsky_float right) {
+  switch (operator) {
+  case wsky_Operator_PLUS: RETURN_FLOAT(left + right);
+  case wsky_Operator_MINUS: RETURN_FLOAT(left - right);
+  case wsky_Operator_STAR: RETURN_FLOAT(left * right);
+  case wsky_Operator_SLASH: RETURN_FLOAT(left / right);
+  case wsky_Operator_LT: RETURN_BOOL(left < right);
+  case wsky_Operator_GT: RETURN_BOOL(left > right);
+  default:
+    return wsky_doBinaryOperation(Value_fromFloat(left), operator,
+                                  Value_fromFloat(right));
+  }
+}
+
+static ReturnValue evalQuickenedString(Value left, Operator operator,
+                                       Value right) {
+  const String *l = (const String *)Value_getObject(left);
+  const String *r = (const String *)Value_getObject(right);
+  switch (operator) {
+  case wsky_Operator_PLUS:
+    RETURN_OBJECT((Object *)wsky_String_concat(l, r));
+  case wsky_Operator_EQUALS:
+    RETURN_BOOL(strcmp(l->string, r->string) == 0);
+  case wsky_Operator_NOT_EQUALS:
+    RETURN_BOOL(strcmp(l->string, r->string) != 0);
+  default:
+    return wsky_doBinaryOperation(left, operator, right);
+  }
+}
+
+ReturnValue wsky_eval_binaryOperator(const OperatorNode *node,
+                                     Value left, Value right) {
+  /* The feedback is the only mutable part of the node */
+  OperatorNode *site = (OperatorNode *)node;
+  TypeFeedback *f = &site->feedback;
+  Operator operator = node->operator;
+
+  switch (f->specialization) {
+  case wsky_OperandTypes_INT:
+    if (isInt(left) && isInt(right)) {
+      f->hits++;
+      return evalQuickenedInt(Value_getInt(left), operator,
+                              Value_getInt(right));
+    }
+    break;
+
+  case wsky_OperandTypes_FLOAT:
+    if (isFloat(left) && isFloat(right)) {
+      f->hits++;
+      return evalQuickenedFloat(Value_getFloat(left), operator,
+                                Value_getFloat(right));
+    }
+    break;
+
+  case wsky_OperandTypes_STRING:
+    if (wsky_isString(left) && wsky_isString(right)) {
+      f->hits++;
+      return evalQuickenedString(left, operator, right);
+    }
+    break;
+
+  case wsky_OperandTypes_GENERIC:
+    observeOperandTypes(site, getOperandTypes(left, right));
+    return wsky_doBinaryOperation(left, operator, right);
+  }
+
+  despecialize(site);
+  return wsky_doBinaryOperation(left, operator, right);
+}
+
+
+static ReturnValue evalBinOperator(const OperatorNode *node, Scope *scope) {
+  ReturnValue leftRV = wsky_evalNode(node->left, scope);
   if (leftRV.exception)
     return leftRV;
 
-  ReturnValue rightRV = wsky_evalNode(rightNode, scope);
+  ReturnValue rightRV = wsky_evalNode(node->right, scope);
   if (rightRV.exception)
     return rightRV;
 
-  return wsky_doBinaryOperation(leftRV.v, operator, rightRV.v);
+  return wsky_eval_binaryOperator(node, leftRV.v, rightRV.v);
 }
 
 
@@ -215,13 +426,9 @@ static ReturnValue evalUnaryOperator(Operator operator,
 }
 
 static ReturnValue evalOperator(const OperatorNode *n, Scope *scope) {
-  Operator op = n->operator;
-  Node *leftNode = n->left;
-  Node *rightNode = n->right;
-  if (leftNode) {
-    return evalBinOperator(leftNode, op, rightNode, scope);
-  }
-  return evalUnaryOperator(op, rightNode, scope);
+  if (n->left)
+    return evalBinOperator(n, scope);
+  return evalUnaryOperator(n->operator, n->right, scope);
 }
 
 
@@ -240,12 +447,14 @@ ReturnValue wsky_evalSequence(const SequenceNode *node,
 
 static ReturnValue evalSequence(const SequenceNode *node,
                                 Scope *parentScope) {
-  Scope *innerScope = wsky_Scope_new(parentScope,
-                                     parentScope->defClass,
-                                     parentScope->self);
+  Scope *innerScope = wsky_Scope_enter(parentScope,
+                                       parentScope->defClass,
+                                       parentScope->self,
+                                       node->layout);
   wsky_eval_pushScope(innerScope);
   ReturnValue rv = wsky_evalSequence(node, innerScope);
   wsky_eval_popScope();
+  wsky_Scope_leave(innerScope);
   return rv;
 }
 
@@ -265,6 +474,16 @@ static ReturnValue declareVariable(const char *name, Value value,
   RETURN_VALUE(value);
 }
 
+static ReturnValue declareVar(const VarNode *n, Value value, Scope *scope) {
+  if (!wsky_LexicalAddress_isResolved(n->address))
+    return declareVariable(n->name, value, scope);
+
+  assert(n->address.depth == 0);
+  if (wsky_Scope_declareSlot(scope, n->address.slot, value))
+    return createAlreadyDeclaredNameError(n->name);
+  RETURN_VALUE(value);
+}
+
 static ReturnValue evalVar(const VarNode *n, Scope *scope) {
   Value value = Value_NULL;
   if (n->right) {
@@ -273,7 +492,7 @@ static ReturnValue evalVar(const VarNode *n, Scope *scope) {
       return rv;
     value = rv.v;
   }
-  return declareVariable(n->name, value, scope);
+  return declareVar(n, value, scope);
 }
 
 
@@ -286,6 +505,12 @@ static ReturnValue raiseUndeclaredNameError(const char *name) {
 
 
 static ReturnValue evalIdentifier(const IdentifierNode *n, Scope *scope) {
+  if (wsky_LexicalAddress_isResolved(n->address)) {
+    Value *variable = wsky_Scope_getSlot(scope, n->address);
+    if (variable)
+      RETURN_VALUE(*variable);
+  }
+
   const char *name = n->name;
   if (!wsky_Scope_containsVariable(scope, name))
     return raiseUndeclaredNameError(name);
@@ -314,9 +539,17 @@ static ReturnValue evalSuperclass(Scope *scope) {
 
 
 static ReturnValue assignToVariable(Value right,
-                                    const char *name,
+                                    const IdentifierNode *identifier,
                                     Scope *scope) {
+  if (wsky_LexicalAddress_isResolved(identifier->address)) {
+    Value *variable = wsky_Scope_getSlot(scope, identifier->address);
+    if (variable) {
+      *variable = right;
+      RETURN_VALUE(right);
+    }
+  }
 
+  const char *name = identifier->name;
   if (!wsky_Scope_containsVariable(scope, name))
     return raiseUndeclaredNameError(name);
 
@@ -341,8 +574,14 @@ static bool isMutableObject(Object *object) {
   return !object->class->native;
 }
 
+/* Returns the name of the member of the node, with its slot and selector */
+static MemberName getMemberName(const MemberAccessNode *dotNode) {
+  MemberName member = {dotNode->name, dotNode->fieldSlot, dotNode->selector};
+  return member;
+}
+
 static ReturnValue assignToObject(Object *object,
-                                  const char *attribute,
+                                  const MemberAccessNode *dotNode,
                                   Value right,
                                   Scope *scope) {
   if (!isMutableObject(object)) {
@@ -350,42 +589,52 @@ static ReturnValue assignToObject(Object *object,
     RAISE_EXCEPTION(e);
   }
 
-  if (object->class == wsky_Structure_CLASS)
-    return wsky_Structure_set((Structure *)object, attribute, right);
+  if (object->class == wsky_Structure_CLASS) {
+    /* The cache is not a part of the node */
+    ShapeCache *cache = (ShapeCache *)&dotNode->shapeCache;
+    return wsky_Structure_setCached((Structure *)object, dotNode->name,
+                                    right, cache);
+  }
 
+  MemberName member = getMemberName(dotNode);
   bool privateAccess = object == scope->self;
   if (object && privateAccess)
     return wsky_Class_setPrivate(scope->defClass, object,
-                                 attribute, right);
+                                 &member, right);
   else
     return wsky_Class_set(wsky_Object_getClass(object), object,
-                          attribute, right);
+                          &member, right);
+}
+
+static ReturnValue setMember(Value value, const MemberAccessNode *dotNode,
+                             Value right, Scope *scope) {
+  if (Value_getType(value) != Type_OBJECT)
+    RAISE_EXCEPTION(createImmutableObjectError(value));
+
+  return assignToObject(Value_getObject(value), dotNode, right, scope);
 }
 
-static ReturnValue assignToMember(Node *leftNode,
-                                  const char *attribute,
+static ReturnValue assignToMember(const MemberAccessNode *dotNode,
                                   Value right,
                                   Scope *scope) {
+  Node *leftNode = dotNode->left;
+
   if (leftNode->type == wsky_ASTNodeType_SUPER) {
     if (!scope->defClass)
       RAISE_NEW_EXCEPTION("'super' used outside of a class");
     if (!scope->defClass->super)
       RAISE_NEW_EXCEPTION("No superclass");
     Object *object = scope->self;
+    MemberName member = getMemberName(dotNode);
     return wsky_Class_set(scope->defClass->super, object,
-                          attribute, right);
+                          &member, right);
   }
 
   ReturnValue rv = wsky_evalNode(leftNode, scope);
   if (rv.exception)
     return rv;
 
-  if (rv.v.type != Type_OBJECT)
-    RAISE_EXCEPTION(createImmutableObjectError(rv.v));
-
-  Object *object = rv.v.v.objectValue;
-
-  return assignToObject(object, attribute, right, scope);
+  return setMember(rv.v, dotNode, right, scope);
 }
 
 static ReturnValue evalAssignment(const AssignmentNode *n,
@@ -399,11 +648,11 @@ static ReturnValue evalAssignment(const AssignmentNode *n,
 
   if (leftNode->type == wsky_ASTNodeType_IDENTIFIER) {
     IdentifierNode *id = (IdentifierNode *) leftNode;
-    return assignToVariable(right.v, id->name, scope);
+    return assignToVariable(right.v, id, scope);
   }
   if (leftNode->type == wsky_ASTNodeType_MEMBER_ACCESS) {
     MemberAccessNode *member = (MemberAccessNode *) leftNode;
-    return assignToMember(member->left, member->name, right.v, scope);
+    return assignToMember(member, right.v, scope);
   }
 
   RAISE_NEW_EXCEPTION("Not assignable expression");
@@ -416,46 +665,66 @@ static ReturnValue evalFunction(const FunctionNode *n, Scope *scope) {
 }
 
 
-static ReturnValue evalParameters(Value *values,
-                                  unsigned valueCount,
-                                  const NodeList *nodes,
+/*
+ * Evaluates the parameters of a call into values allocated on the
+ * stack. The caller releases them with wsky_stack_release().
+ */
+static ReturnValue evalParameters(Value **values,
+                                  const CallNode *callNode,
                                   Scope *scope) {
-  unsigned paramCount = wsky_ASTNodeList_getCount(nodes);
-  if (paramCount > valueCount)
-    RAISE_NEW_EXCEPTION("Too many parameters");
+  const NodeList *nodes = callNode->children;
+  unsigned paramCount = callNode->parameterCount;
+  Value *parameters = wsky_stack_allocate(paramCount);
 
   for (unsigned i = 0; i < paramCount; i++) {
     ReturnValue rv = wsky_evalNode(nodes->node, scope);
-    if (rv.exception)
+    if (rv.exception) {
+      wsky_stack_release(parameters);
       return rv;
-    values[i] = rv.v;
+    }
+    parameters[i] = rv.v;
     nodes = nodes->next;
   }
 
+  *values = parameters;
   RETURN_NULL;
 }
 
 
-static ReturnValue callMethod(Object *instanceMethod_,
+static ReturnValue callMethod(Method *method, Value self,
                               unsigned parameterCount,
                               Value *parameters) {
-  InstanceMethod *instanceMethod;
-  instanceMethod = (InstanceMethod *) instanceMethod_;
-  Method *method = instanceMethod->method;
-
-  Value self = instanceMethod->self;
-
-  if (self.type == Type_OBJECT && self.v.objectValue) {
+  if (Value_getType(self) == Type_OBJECT && Value_getObject(self)) {
     return wsky_Method_call(method,
-                            self.v.objectValue,
+                            Value_getObject(self),
                             parameterCount,
                             parameters);
+  } else {
+    return wsky_Method_callValue(method,
+                                 self,
+                                 parameterCount,
+                                 parameters);
   }
+}
 
-  return wsky_Method_callValue(method,
-                               self,
-                               parameterCount,
-                               parameters);
+static ReturnValue tailCallMethod(Method *method, Value self,
+                                  unsigned parameterCount,
+                                  Value *parameters) {
+  if (Value_getType(self) == Type_OBJECT && Value_getObject(self))
+    return wsky_Method_tailCall(method,
+                                Value_getObject(self),
+                                parameterCount,
+                                parameters);
+  return callMethod(method, self, parameterCount, parameters);
+}
+
+static ReturnValue callInstanceMethod(Object *instanceMethod_,
+                                      unsigned parameterCount,
+                                      Value *parameters) {
+  InstanceMethod *instanceMethod;
+  instanceMethod = (InstanceMethod *) instanceMethod_;
+  return callMethod(instanceMethod->method, instanceMethod->self,
+                    parameterCount, parameters);
 }
 
 static inline ReturnValue callClass(Class *class,
@@ -473,6 +742,40 @@ static Exception *createNotCallableError(Value value) {
   return e;
 }
 
+static ReturnValue callValue(Value callee,
+                             unsigned paramCount,
+                             Value *parameters) {
+  if (Value_getType(callee) != Type_OBJECT)
+    RAISE_EXCEPTION(createNotCallableError(callee));
+
+  if (wsky_isFunction(callee)) {
+    Function *function = (Function *)Value_getObject(callee);
+    return wsky_Function_call(function, paramCount, parameters);
+  }
+
+  if (wsky_isInstanceMethod(callee))
+    return callInstanceMethod(Value_getObject(callee), paramCount,
+                              parameters);
+
+  if (wsky_isClass(callee)) {
+    Class *class = (Class *)Value_getObject(callee);
+    return callClass(class, paramCount, parameters);
+  }
+
+  RAISE_EXCEPTION(createNotCallableError(callee));
+}
+
+static ReturnValue tailCallValue(Value callee,
+                                 unsigned paramCount,
+                                 Value *parameters) {
+  if (wsky_isFunction(callee)) {
+    Function *function = (Function *)Value_getObject(callee);
+    if (wsky_Function_canTailCall(function, paramCount))
+      return wsky_Function_tailCall(function, paramCount, parameters);
+  }
+  return callValue(callee, paramCount, parameters);
+}
+
 static ReturnValue evalSuperCall(const CallNode *callNode, Scope *scope) {
     Class *class = scope->defClass;
     if (!class)
@@ -480,108 +783,193 @@ static ReturnValue evalSuperCall(const CallNode *callNode, Scope *scope) {
     if (!class->super)
       RAISE_NEW_EXCEPTION("No superclass");
 
-    Value parameters[32];
-
-    ReturnValue rv = evalParameters(parameters, 32,
-                                    callNode->children, scope);
+    Value *parameters;
+    ReturnValue rv = evalParameters(&parameters, callNode, scope);
     if (rv.exception)
       return rv;
 
-    unsigned paramCount = wsky_ASTNodeList_getCount(callNode->children);
+    unsigned paramCount = callNode->parameterCount;
 
     Object *self = scope->self;
     rv = wsky_Method_call(class->super->constructor, self,
                                       paramCount, parameters);
+    wsky_stack_release(parameters);
     if (rv.exception)
       return rv;
     RETURN_OBJECT(self);
 }
 
-static ReturnValue evalCall(const CallNode *callNode, Scope *scope) {
-  if (callNode->left->type == wsky_ASTNodeType_SUPER)
-    return evalSuperCall(callNode, scope);
+static ReturnValue getMember(Value value, const MemberAccessNode *dotNode,
+                             Scope *scope);
+static Method *findMethod(Value self, const MemberAccessNode *dotNode,
+                          Scope *scope);
 
-  ReturnValue rv = wsky_evalNode(callNode->left, scope);
+/*
+ * Calls `self.name(...)`. If the member is a method, it is called
+ * directly with its receiver, without creating an InstanceMethod.
+ */
+static ReturnValue evalMethodCall(const CallNode *callNode, Scope *scope) {
+  const MemberAccessNode *dotNode = (const MemberAccessNode *)callNode->left;
+
+  ReturnValue rv = wsky_evalNode(dotNode->left, scope);
   if (rv.exception)
     return rv;
+  Value self = rv.v;
 
-  Value parameters[32];
+  Method *method = findMethod(self, dotNode, scope);
+  if (!method) {
+    rv = getMember(self, dotNode, scope);
+    if (rv.exception)
+      return rv;
+  }
 
-  ReturnValue prv = evalParameters(parameters, 32,
-                                   callNode->children, scope);
+  Value *parameters;
+  ReturnValue prv = evalParameters(&parameters, callNode, scope);
   if (prv.exception)
     return prv;
 
-  unsigned paramCount = wsky_ASTNodeList_getCount(callNode->children);
+  unsigned paramCount = callNode->parameterCount;
 
-  if (rv.v.type != Type_OBJECT) {
-    RAISE_EXCEPTION(createNotCallableError(rv.v));
-  }
+  if (method && callNode->tailCall)
+    rv = tailCallMethod(method, self, paramCount, parameters);
+  else if (method)
+    rv = callMethod(method, self, paramCount, parameters);
+  else if (callNode->tailCall)
+    rv = tailCallValue(rv.v, paramCount, parameters);
+  else
+    rv = callValue(rv.v, paramCount, parameters);
+  wsky_stack_release(parameters);
+  return rv;
+}
 
-  if (wsky_isFunction(rv.v)) {
-    Object *function = rv.v.v.objectValue;
-    rv = wsky_Function_call((Function *) function,
-                            paramCount, parameters);
+static ReturnValue evalCall(const CallNode *callNode, Scope *scope) {
+  if (callNode->left->type == wsky_ASTNodeType_SUPER)
+    return evalSuperCall(callNode, scope);
 
-  } else if (wsky_isInstanceMethod(rv.v)) {
-    Object *instMethod = rv.v.v.objectValue;
-    rv = callMethod(instMethod, paramCount, parameters);
+  if (callNode->left->type == wsky_ASTNodeType_MEMBER_ACCESS) {
+    const MemberAccessNode *dotNode;
+    dotNode = (const MemberAccessNode *)callNode->left;
+    if (dotNode->left->type != wsky_ASTNodeType_SUPER)
+      return evalMethodCall(callNode, scope);
+  }
 
-  } else if (wsky_isClass(rv.v)) {
-    Class *class = (Class *)rv.v.v.objectValue;
-    rv = callClass(class, paramCount, parameters);
+  ReturnValue rv = wsky_evalNode(callNode->left, scope);
+  if (rv.exception)
+    return rv;
 
-  } else {
-    RAISE_EXCEPTION(createNotCallableError(rv.v));
-  }
+  Value *parameters;
+  ReturnValue prv = evalParameters(&parameters, callNode, scope);
+  if (prv.exception)
+    return prv;
 
+  unsigned paramCount = callNode->parameterCount;
+
+  if (callNode->tailCall)
+    rv = tailCallValue(rv.v, paramCount, parameters);
+  else
+    rv = callValue(rv.v, paramCount, parameters);
+  wsky_stack_release(parameters);
   return rv;
 }
 
 static ReturnValue getFallbackMember(Class *class, Value self,
-                                     const char *attribute) {
+                                     const MemberAccessNode *dotNode) {
+  const char *attribute = dotNode->name;
   if (class == wsky_Module_CLASS) {
-    assert(self.type == Type_OBJECT);
+    assert(Value_getType(self) == Type_OBJECT);
 
-    Module *module = (Module *)self.v.objectValue;
+    Module *module = (Module *)Value_getObject(self);
     Value *member = wsky_Dict_get(&module->members, attribute);
     if (member)
       RETURN_VALUE(*member);
   } else if (class == wsky_Structure_CLASS) {
-    return wsky_Structure_get((Structure *)self.v.objectValue,
-                              attribute);
+    /* The cache is not a part of the node */
+    ShapeCache *cache = (ShapeCache *)&dotNode->shapeCache;
+    return wsky_Structure_getCached((Structure *)Value_getObject(self),
+                                    attribute, cache);
   }
 
   return wsky_AttributeError_raiseNoAttr(class->name, attribute);
 }
 
+/*
+ * Finds the method of a member access with the selector given by the
+ * resolver, without hashing the name.
+ */
+static Method *findMethodOfNode(Class *class,
+                                const MemberAccessNode *dotNode) {
+  if (dotNode->selector < 0)
+    return wsky_Class_findMethodOrGetter(class, dotNode->name);
+  return wsky_Class_findMethodBySelector(class,
+                                         (unsigned)dotNode->selector);
+}
+
 static ReturnValue getMemberOfNativeClass(Value self,
-                                          const char *attribute) {
+                                          const MemberAccessNode *dotNode) {
   Class *class = wsky_getClass(self);
 
-  Method *method = wsky_Class_findMethodOrGetter(class, attribute);
+  Method *method = findMethodOfNode(class, dotNode);
   if (!method)
-    return getFallbackMember(class, self, attribute);
+    return getFallbackMember(class, self, dotNode);
 
   if (method->flags & wsky_MethodFlags_GET) {
     if (method->flags & wsky_MethodFlags_VALUE)
       return wsky_Method_callValue0(method, self);
     else
-      return wsky_Method_call0(method, self.v.objectValue);
+      return wsky_Method_call0(method, Value_getObject(self));
   }
 
   InstanceMethod *im = wsky_InstanceMethod_new(method, self);
   RETURN_OBJECT((Object *)im);
 }
 
-static ReturnValue getAttribute(Object *object, const char *attribute,
+static ReturnValue getAttribute(Object *object,
+                                const MemberAccessNode *dotNode,
                                 Scope *scope) {
+  MemberName member = getMemberName(dotNode);
   bool privateAccess = object == scope->self;
   if (object && privateAccess)
-    return wsky_Class_getPrivate(scope->defClass, object, attribute);
+    return wsky_Class_getPrivate(scope->defClass, object, &member);
   else
-    return wsky_Class_get(wsky_Object_getClass(object), object,
-                          attribute);
+    return wsky_Class_get(wsky_Object_getClass(object), object, &member);
+}
+
+static ReturnValue getMember(Value value, const MemberAccessNode *dotNode,
+                             Scope *scope) {
+  if (Value_getType(value) != Type_OBJECT)
+    return getMemberOfNativeClass(value, dotNode);
+
+  Object *object = Value_getObject(value);
+
+  if (wsky_Object_getClass(object)->native)
+    return getMemberOfNativeClass(value, dotNode);
+
+  return getAttribute(object, dotNode, scope);
+}
+
+/*
+ * Returns the method which getMember() would bind to the value, or NULL
+ * if the member is not a method.
+ */
+static Method *findMethod(Value self, const MemberAccessNode *dotNode,
+                          Scope *scope) {
+  Class *class = wsky_getClass(self);
+  bool privateAccess = false;
+
+  if (!class->native && Value_getObject(self) == scope->self) {
+    class = scope->defClass;
+    if (!wsky_Object_isA(scope->self, class))
+      return NULL;
+    privateAccess = true;
+  }
+
+  Method *method = findMethodOfNode(class, dotNode);
+  if (!method || (method->flags & wsky_MethodFlags_GET))
+    return NULL;
+  if (!class->native && !privateAccess &&
+      !(method->flags & wsky_MethodFlags_PUBLIC))
+    return NULL;
+  return method;
 }
 
 static ReturnValue evalMemberAccess(const MemberAccessNode *dotNode,
@@ -592,22 +980,15 @@ static ReturnValue evalMemberAccess(const MemberAccessNode *dotNode,
     if (!scope->defClass->super)
       RAISE_NEW_EXCEPTION("No superclass");
     Object *object = scope->self;
-    return wsky_Class_get(scope->defClass->super, object, dotNode->name);
+    MemberName member = getMemberName(dotNode);
+    return wsky_Class_get(scope->defClass->super, object, &member);
   }
 
   ReturnValue rv = wsky_evalNode(dotNode->left, scope);
   if (rv.exception)
     return rv;
 
-  if (rv.v.type != Type_OBJECT)
-    return getMemberOfNativeClass(rv.v, dotNode->name);
-
-  Object *object = rv.v.v.objectValue;
-
-  if (wsky_Object_getClass(object)->native)
-    return getMemberOfNativeClass(rv.v, dotNode->name);
-
-  return getAttribute(object, dotNode->name, scope);
+  return getMember(rv.v, dotNode, scope);
 }
 
 
@@ -621,7 +1002,7 @@ static ReturnValue evalClassMember(Class *class,
     if (rv.exception)
       return rv;
     assert(wsky_isFunction(rv.v));
-    right = (Function *)rv.v.v.objectValue;
+    right = (Function *)Value_getObject(rv.v);
   } else {
     assert((memberNode->flags & wsky_MethodFlags_SET) ||
            (memberNode->flags & wsky_MethodFlags_GET));
@@ -645,10 +1026,8 @@ static void addMethodToClass(Class *class, Method *method) {
 
   if (flags & wsky_MethodFlags_INIT)
     class->constructor = method;
-  else if (flags & wsky_MethodFlags_SET)
-    wsky_Dict_set(class->setters, method->name, method);
   else
-    wsky_Dict_set(class->methods, method->name, method);
+    wsky_Class_addMethod(class, method);
 }
 
 
@@ -683,11 +1062,11 @@ static ReturnValue createClass(const ClassNode *classNode,
   if (!wsky_isClass(rv.v))
     RAISE_NEW_PARAMETER_ERROR("Invalid superclass");
 
-  Class *super = (Class *)rv.v.v.objectValue;
+  Class *super = (Class *)Value_getObject(rv.v);
   if (super->final)
     RAISE_NEW_PARAMETER_ERROR("Cannot extend a final class");
 
-  Class *class = wsky_Class_new(classNode->name, super);
+  Class *class = wsky_Class_new(classNode->name, super, classNode->fields);
   if (!class)
     RAISE_NEW_EXCEPTION("Class creation failed");
 
@@ -698,7 +1077,7 @@ static ReturnValue evalClass(const ClassNode *classNode, Scope *scope) {
   ReturnValue rv = createClass(classNode, scope);
   if (rv.exception)
     return rv;
-  Class *class = (Class *)rv.v.v.objectValue;
+  Class *class = (Class *)Value_getObject(rv.v);
 
   for (NodeList *list = classNode->children; list; list = list->next) {
     Node *node = list->node;
@@ -707,11 +1086,12 @@ static ReturnValue evalClass(const ClassNode *classNode, Scope *scope) {
     rv = evalClassMember(class, member, scope);
     if (rv.exception)
       return rv;
-    addMethodToClass(class, (Method *)rv.v.v.objectValue);
+    addMethodToClass(class, (Method *)Value_getObject(rv.v));
   }
 
   if (!class->constructor)
     class->constructor = createDefaultConstructor(class);
+  wsky_Class_finalize(class);
 
   Value classValue = Value_fromObject((Object *)class);
   return declareVariable(class->name, classValue, scope);
@@ -805,7 +1185,7 @@ static ReturnValue evalImport(const ImportNode *node, Scope *scope) {
         wsky_free(targetPath);
         return rv;
       }
-      module = (Module *)rv.v.v.objectValue;
+      module = (Module *)Value_getObject(rv.v);
     }
     wsky_free(targetPath);
 
@@ -852,7 +1232,7 @@ static ReturnValue evalIf(const IfNode *node, Scope *scope) {
       return rv;
     if (!wsky_isBoolean(rv.v))
       RAISE_NEW_TYPE_ERROR("Expected a boolean");
-    if (rv.v.v.boolValue)
+    if (Value_getBool(rv.v))
       return wsky_evalNode(expressions->node, scope);
 
     expressions = expressions->next;
@@ -866,6 +1246,90 @@ static ReturnValue evalIf(const IfNode *node, Scope *scope) {
 }
 
 
+Scope *wsky_eval_enterLoop(const LoopNode *node, Scope *parent) {
+  assert(node->layout);
+  Scope *scope = wsky_Scope_enter(parent, parent->defClass, parent->self,
+                                  node->layout);
+  wsky_eval_pushScope(scope);
+  return scope;
+}
+
+Scope *wsky_eval_nextIteration(Scope *scope) {
+  if (!scope->layout->captured) {
+    wsky_Scope_undeclareSlots(scope);
+    return scope;
+  }
+
+  Scope *parent = scope->parent;
+  wsky_eval_popScope();
+  Scope *next = wsky_Scope_newWithLayout(parent, parent->defClass,
+                                         parent->self, scope->layout);
+  wsky_eval_pushScope(next);
+  return next;
+}
+
+static void leaveLoop(Scope *scope) {
+  wsky_eval_popScope();
+  wsky_Scope_leave(scope);
+}
+
+static ReturnValue evalLoopBody(const LoopNode *node, Scope *scope) {
+  if (node->body->type == wsky_ASTNodeType_SEQUENCE)
+    return wsky_evalSequence((const SequenceNode *)node->body, scope);
+  return wsky_evalNode(node->body, scope);
+}
+
+static ReturnValue evalWhileIterations(const WhileNode *node, Scope **scope) {
+  for (;;) {
+    ReturnValue rv = wsky_evalNode(node->test, *scope);
+    if (rv.exception)
+      return rv;
+    if (!wsky_isBoolean(rv.v))
+      RAISE_NEW_TYPE_ERROR("Expected a boolean");
+    if (!Value_getBool(rv.v))
+      RETURN_NULL;
+
+    rv = evalLoopBody((const LoopNode *)node, *scope);
+    if (rv.exception)
+      return rv;
+    *scope = wsky_eval_nextIteration(*scope);
+  }
+}
+
+static ReturnValue evalWhile(const WhileNode *node, Scope *parent) {
+  Scope *scope = wsky_eval_enterLoop((const LoopNode *)node, parent);
+  ReturnValue rv = evalWhileIterations(node, &scope);
+  leaveLoop(scope);
+  return rv;
+}
+
+static ReturnValue evalFor(const ForNode *node, Scope *parent) {
+  ReturnValue rv = wsky_evalNode(node->iterable, parent);
+  if (rv.exception)
+    return rv;
+
+  Iterator iterator;
+  rv = wsky_Iterator_init(&iterator, rv.v);
+  if (rv.exception)
+    return rv;
+
+  Scope *scope = wsky_eval_enterLoop((const LoopNode *)node, parent);
+  Value element;
+  while (wsky_Iterator_next(&iterator, &element)) {
+    wsky_Scope_declareSlot(scope, 0, element);
+    rv = evalLoopBody((const LoopNode *)node, scope);
+    if (rv.exception)
+      break;
+    scope = wsky_eval_nextIteration(scope);
+  }
+  leaveLoop(scope);
+
+  if (rv.exception)
+    return rv;
+  RETURN_NULL;
+}
+
+
 
 ReturnValue wsky_evalNode(const Node *node, Scope *scope) {
 #define CASE(type) case wsky_ASTNodeType_ ## type
@@ -886,8 +1350,10 @@ ReturnValue wsky_evalNode(const Node *node, Scope *scope) {
   CASE(SEQUENCE):
     return evalSequence((const SequenceNode *) node, scope);
 
-  CASE(STRING):
-    RETURN_C_STRING(TO_LITERAL_NODE(node)->v.stringValue);
+  CASE(STRING): {
+    String *string = wsky_LiteralNode_getString(TO_LITERAL_NODE(node));
+    RETURN_OBJECT((Object *)string);
+  }
 
   CASE(UNARY_OPERATOR):
   CASE(BINARY_OPERATOR):
@@ -932,6 +1398,12 @@ ReturnValue wsky_evalNode(const Node *node, Scope *scope) {
   CASE(IF):
     return evalIf((const IfNode *) node, scope);
 
+  CASE(WHILE):
+    return evalWhile((const WhileNode *) node, scope);
+
+  CASE(FOR):
+    return evalFor((const ForNode *) node, scope);
+
   default:
     fprintf(stderr,
             "wsky_evalNode(): Unsupported node type %d\n",
@@ -942,6 +1414,64 @@ ReturnValue wsky_evalNode(const Node *node, Scope *scope) {
 }
 
 
+ReturnValue wsky_eval_getVariable(const IdentifierNode *identifier,
+                                  Scope *scope) {
+  return evalIdentifier(identifier, scope);
+}
+
+ReturnValue wsky_eval_declareVariable(const VarNode *node, Value value,
+                                      Scope *scope) {
+  return declareVar(node, value, scope);
+}
+
+ReturnValue wsky_eval_assignVariable(const IdentifierNode *identifier,
+                                     Value value,
+                                     Scope *scope) {
+  return assignToVariable(value, identifier, scope);
+}
+
+ReturnValue wsky_eval_call(Value callee,
+                           unsigned parameterCount,
+                           Value *parameters) {
+  return callValue(callee, parameterCount, parameters);
+}
+
+ReturnValue wsky_eval_tailCall(Value callee,
+                               unsigned parameterCount,
+                               Value *parameters) {
+  return tailCallValue(callee, parameterCount, parameters);
+}
+
+ReturnValue wsky_eval_getMember(Value object,
+                                const MemberAccessNode *node,
+                                Scope *scope) {
+  return getMember(object, node, scope);
+}
+
+Method *wsky_eval_findMethod(Value object, const MemberAccessNode *node,
+                             Scope *scope) {
+  return findMethod(object, node, scope);
+}
+
+ReturnValue wsky_eval_callMethod(Method *method, Value object,
+                                 unsigned parameterCount,
+                                 Value *parameters) {
+  return callMethod(method, object, parameterCount, parameters);
+}
+
+ReturnValue wsky_eval_tailCallMethod(Method *method, Value object,
+                                     unsigned parameterCount,
+                                     Value *parameters) {
+  return tailCallMethod(method, object, parameterCount, parameters);
+}
+
+ReturnValue wsky_eval_setMember(Value object, const MemberAccessNode *node,
+                                Value value, Scope *scope) {
+  return setMember(object, node, value, scope);
+}
+
+
+
 static ReturnValue raiseSyntaxError(ParserResult pr) {
   char *msg = wsky_SyntaxError_toString(&pr.syntaxError);
   SyntaxErrorEx *e = wsky_SyntaxErrorEx_new(&pr.syntaxError);
@@ -961,9 +1491,19 @@ static ReturnValue evalFromParserResult(ParserResult pr, Scope *scope) {
   if (!scope)
     scope = wsky_Scope_newRoot(wsky_Module_newMain());
 
+  pr.node = wsky_optimize(pr.node);
+  wsky_resolve(pr.node);
+
   wsky_eval_pushScope(scope);
 
-  ReturnValue rv = wsky_evalNode(pr.node, scope);
+  ReturnValue rv;
+  if (wsky_getEngine() != wsky_Engine_AST) {
+    Code *code = wsky_compile(pr.node);
+    rv = wsky_vm_run(code, scope);
+    wsky_Code_delete(code);
+  } else {
+    rv = wsky_evalNode(pr.node, scope);
+  }
   wsky_ASTNode_delete(pr.node);
 
   wsky_eval_popScope();
@@ -982,7 +1522,7 @@ ReturnValue wsky_evalFile(const char *filePath) {
   if (rv.exception)
     return rv;
 
-  ProgramFile *file = (ProgramFile *)rv.v.v.objectValue;
+  ProgramFile *file = (ProgramFile *)Value_getObject(rv.v);
   return evalFromParserResult(wsky_parseFile(file), NULL);
 }
 
@@ -1008,7 +1548,7 @@ ReturnValue wsky_evalModuleFile(const char *filePath) {
   if (rv.exception)
     return rv;
 
-  ProgramFile *file = (ProgramFile *)rv.v.v.objectValue;
+  ProgramFile *file = (ProgramFile *)Value_getObject(rv.v);
   char *name = wsky_path_removeExtension(file->name);
   if (!isValidIdentifier(name)) {
     wsky_free(name);
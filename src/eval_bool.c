@@ -3,14 +3,14 @@
 
 static ReturnValue boolAnd(bool left, Value right) {
   if (isBool(right)) {
-    RETURN_BOOL(left && right.v.intValue);
+    RETURN_BOOL(left && Value_getBool(right));
   }
   RETURN_FALSE;
 }
 
 static ReturnValue boolOr(bool left, Value right) {
   if (isBool(right)) {
-    RETURN_BOOL(left || right.v.boolValue);
+    RETURN_BOOL(left || Value_getBool(right));
   }
   RETURN_TRUE;
 }
@@ -18,14 +18,14 @@ static ReturnValue boolOr(bool left, Value right) {
 
 static ReturnValue boolEquals(bool left, Value right) {
   if (isBool(right)) {
-    RETURN_BOOL(left == right.v.intValue);
+    RETURN_BOOL(left == Value_getBool(right));
   }
   RETURN_FALSE;
 }
 
 static ReturnValue boolNotEquals(bool left, Value right) {
   if (isBool(right)) {
-    RETURN_BOOL(left != right.v.boolValue);
+    RETURN_BOOL(left != Value_getBool(right));
   }
   RETURN_TRUE;
 }
@@ -46,7 +46,7 @@ static ReturnValue evalBinOperatorBool(bool left,
     break;
   }
 
-  RETURN_NOT_IMPL(wsky_Operator_toString(operator));
+  RETURN_NOT_IMPLEMENTED;
 }
 
 static ReturnValue evalUnaryOperatorBool(wsky_Operator operator,
@@ -4,12 +4,12 @@
 #define OP_TEMPLATE(op, opName)                                         \
   static ReturnValue float##opName(wsky_float left, Value right) {      \
     if (isInt(right)) {                                                 \
-      RETURN_FLOAT(left op right.v.intValue);                      \
+      RETURN_FLOAT(left op Value_getInt(right));                      \
     }                                                                   \
     if (isFloat(right)) {                                               \
-      RETURN_FLOAT(left op right.v.floatValue);                    \
+      RETURN_FLOAT(left op Value_getFloat(right));                    \
     }                                                                   \
-    RETURN_NOT_IMPL(#op);                                               \
+    RETURN_NOT_IMPLEMENTED;                                             \
   }
 
 OP_TEMPLATE(+, Plus)
@@ -23,12 +23,12 @@ OP_TEMPLATE(/, Slash)
 #define OP_TEMPLATE(op, opName)                                         \
   static ReturnValue float##opName(wsky_float left, Value right) {      \
     if (isInt(right)) {                                                 \
-      RETURN_BOOL(left op right.v.intValue);                       \
+      RETURN_BOOL(left op Value_getInt(right));                       \
     }                                                                   \
     if (isFloat(right)) {                                               \
-      RETURN_BOOL(left op right.v.floatValue);                     \
+      RETURN_BOOL(left op Value_getFloat(right));                     \
     }                                                                   \
-    RETURN_NOT_IMPL(#op);                                               \
+    RETURN_NOT_IMPLEMENTED;                                             \
   }
 
 OP_TEMPLATE(<, LT)
@@ -54,7 +54,7 @@ static ReturnValue evalBinOperatorFloat(wsky_float left,
     break;
   }
 
-  RETURN_NOT_IMPL(wsky_Operator_toString(operator));
+  RETURN_NOT_IMPLEMENTED;
 }
 
 
@@ -2,32 +2,32 @@
 
 #include "whiskey_private.h"
 
-#define OP_TEMPLATE(op, opName)                                 \
+#define OP_TEMPLATE(op, opName, intFunction)                    \
   static ReturnValue int##opName(wsky_int left, Value right) {  \
     if (isInt(right)) {                                         \
-      RETURN_INT(left op right.v.intValue);                     \
+      return intFunction(left, Value_getInt(right));            \
     }                                                           \
     if (isFloat(right)) {                                       \
-      RETURN_FLOAT(left op right.v.floatValue);                 \
+      RETURN_FLOAT(left op Value_getFloat(right));              \
     }                                                           \
-    RETURN_NOT_IMPL(#op);                                       \
+    RETURN_NOT_IMPLEMENTED;                                     \
   }
 
-OP_TEMPLATE(+, Plus)
-OP_TEMPLATE(-, Minus)
-OP_TEMPLATE(*, Star)
+OP_TEMPLATE(+, Plus, intSum)
+OP_TEMPLATE(-, Minus, intDifference)
+OP_TEMPLATE(*, Star, intProduct)
 
 static ReturnValue intSlash(wsky_int left, Value right) {
   if (isInt(right)) {
-    wsky_int divisor = right.v.intValue;
+    wsky_int divisor = Value_getInt(right);
     if (divisor == 0)
       RAISE_EXCEPTION((Exception *)wsky_ZeroDivisionError_new());
-    RETURN_INT(left / divisor);
+    return intQuotient(left, divisor);
   }
   if (isFloat(right)) {
-    RETURN_FLOAT(left / right.v.floatValue);
+    RETURN_FLOAT(left / Value_getFloat(right));
   }
-  RETURN_NOT_IMPL("/");
+  RETURN_NOT_IMPLEMENTED;
 }
 
 
@@ -37,12 +37,12 @@ static ReturnValue intSlash(wsky_int left, Value right) {
 #define OP_TEMPLATE(op, opName)                                 \
   static ReturnValue int##opName(wsky_int left, Value right) {  \
     if (isInt(right)) {                                         \
-      RETURN_BOOL(left op right.v.intValue);                    \
+      RETURN_BOOL(left op Value_getInt(right));                    \
     }                                                           \
     if (isFloat(right)) {                                       \
-      RETURN_BOOL(left op right.v.floatValue);                  \
+      RETURN_BOOL(left op Value_getFloat(right));                  \
     }                                                           \
-    RETURN_NOT_IMPL(#op);                                       \
+    RETURN_NOT_IMPLEMENTED;                                     \
   }
 
 OP_TEMPLATE(<, LT)
@@ -53,9 +53,9 @@ OP_TEMPLATE(>, GT)
 #define OP_TEMPLATE(op, opName)                                 \
   static ReturnValue int##opName(wsky_int left, Value right) {  \
     if (isInt(right)) {                                         \
-      RETURN_BOOL(left op right.v.intValue);                    \
+      RETURN_BOOL(left op Value_getInt(right));                    \
     }                                                           \
-    RETURN_NOT_IMPL(#op);                                       \
+    RETURN_NOT_IMPLEMENTED;                                     \
   }
 
 OP_TEMPLATE(<=, LTE)
@@ -76,15 +76,15 @@ static ReturnValue evalBinOperatorInt(wsky_int left,
 
   case wsky_Operator_EQUALS:
     if (isInt(right)) {
-      RETURN_BOOL(left == right.v.intValue);
+      RETURN_BOOL(left == Value_getInt(right));
     }
-    RETURN_NOT_IMPL(wsky_Operator_toString(operator));
+    RETURN_NOT_IMPLEMENTED;
 
   case wsky_Operator_NOT_EQUALS:
     if (isInt(right)) {
-      RETURN_BOOL(left != right.v.intValue);
+      RETURN_BOOL(left != Value_getInt(right));
     }
-    RETURN_NOT_IMPL(wsky_Operator_toString(operator));
+    RETURN_NOT_IMPLEMENTED;
 
   case wsky_Operator_LT: return intLT(left, right);
   case wsky_Operator_LT_EQ: return intLTE(left, right);
@@ -95,7 +95,7 @@ static ReturnValue evalBinOperatorInt(wsky_int left,
     break;
   }
 
-  RETURN_NOT_IMPL(wsky_Operator_toString(operator));
+  RETURN_NOT_IMPLEMENTED;
 }
 
 
@@ -103,7 +103,7 @@ static ReturnValue evalUnaryOperatorInt(wsky_Operator operator,
                                         wsky_int right) {
   switch (operator) {
   case wsky_Operator_PLUS: RETURN_INT(right);
-  case wsky_Operator_MINUS: RETURN_INT(-right);
+  case wsky_Operator_MINUS: return intNegation(right);
 
   default:
     break;
@@ -24,8 +24,8 @@ void wsky_GC_visitObject(void *objectVoid) {
 }
 
 void wsky_GC_visitValue(Value value) {
-  if (value.type == Type_OBJECT) {
-    wsky_GC_visitObject(value.v.objectValue);
+  if (Value_getType(value) == Type_OBJECT) {
+    wsky_GC_visitObject(Value_getObject(value));
   }
 }
 
@@ -43,18 +43,70 @@ static void visitModules(void) {
   }
 }
 
+/** The roots added with wsky_GC_addRoot() */
+static GCRoot *roots = NULL;
+
+void wsky_GC_addRoot(GCRoot *root, Object *object) {
+  assert(!root->object);
+  assert(object);
+  root->object = object;
+  root->previous = NULL;
+  root->next = roots;
+  if (roots)
+    roots->previous = root;
+  roots = root;
+}
+
+void wsky_GC_removeRoot(GCRoot *root) {
+  if (!root->object)
+    return;
+  if (root->previous)
+    root->previous->next = root->next;
+  else
+    roots = root->next;
+  if (root->next)
+    root->next->previous = root->previous;
+  *root = wsky_GCRoot_EMPTY;
+}
+
+static void visitRoots(void) {
+  for (GCRoot *root = roots; root; root = root->next)
+    wsky_GC_visitObject(root->object);
+}
+
+static void removeRoots(void) {
+  while (roots)
+    wsky_GC_removeRoot(roots);
+}
+
+
 static void visitBuiltins(void) {
   visitBuiltinClasses();
   visitModules();
+  visitRoots();
+  wsky_GC_visitObject(ReturnValue_NOT_IMPLEMENTED.exception);
+  wsky_Function_visitTailCall();
+  wsky_stack_visit();
+}
+
+/* Returns the object of a word which may be a boxed value */
+static Object *unboxWord(Object *word) {
+#ifdef WSKY_NAN_BOXING
+  uint64_t bits = (uint64_t)(uintptr_t)word;
+  if ((bits & wsky_Value_TAG_MASK) == wsky_Value_OBJECT_TAG)
+    return (Object *)(uintptr_t)(bits & wsky_Value_PAYLOAD_MASK);
+#endif
+  return word;
 }
 
 static void visitObjectArray(void *pointers_, size_t size) {
   Object **pointers = (Object **)pointers_;
   ptrdiff_t s = (ptrdiff_t)size;
   while (s > 0) {
-    if (wsky_heaps_contains(*pointers)) {
-      assert((*pointers)->class);
-      wsky_GC_visitObject(*pointers);
+    Object *object = unboxWord(*pointers);
+    if (wsky_heaps_contains(object)) {
+      assert(object->class);
+      wsky_GC_visitObject(object);
     }
     pointers++;
     s -= sizeof(Object *);
@@ -132,6 +184,7 @@ void wsky_GC_autoCollect(void) {
 }
 
 void wsky_GC_deleteAll(void) {
+  removeRoots();
   wsky_GC_unmarkAll();
   wsky_heaps_deleteUnmarkedObjects();
   wsky_heaps_free();
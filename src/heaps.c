@@ -71,9 +71,8 @@ static void deleteObject(Object *object) {
     class = class->super;
   }
 
-  if (!object->class->native) {
-    wsky_ObjectFields_free(&object->fields);
-  }
+  if (!object->class->native)
+    wsky_Object_freeFields(object);
 
   wsky_heaps_freeObject(object);
 }
@@ -238,6 +237,13 @@ void wsky_heaps_free(void) {
     Heap_delete(heap);
     heap = next;
   }
+
+  /* Whiskey can be started again */
+  heaps.heaps = NULL;
+  heaps.lowestAddress = NULL;
+  heaps.highestAddress = NULL;
+  heaps.heapSize = INITIAL_HEAP_SIZE;
+  heaps.freeObjects = NULL;
 }
 
 
@@ -0,0 +1,42 @@
+#include "whiskey_private.h"
+
+
+static ReturnValue raiseNotIterableError(Value value) {
+  char *message = wsky_asprintf("'%s' objects are not iterable",
+                                wsky_getClassName(value));
+  Exception *e = (Exception *)wsky_TypeError_new(message);
+  wsky_free(message);
+  RAISE_EXCEPTION(e);
+}
+
+ReturnValue wsky_Iterator_init(Iterator *iterator, Value iterable) {
+  if (!wsky_isInteger(iterable) && !wsky_isString(iterable))
+    return raiseNotIterableError(iterable);
+
+  iterator->iterable = iterable;
+  iterator->index = 0;
+  RETURN_NULL;
+}
+
+
+static bool nextCharacter(Iterator *iterator, Value *element) {
+  const String *string = (const String *)Value_getObject(iterator->iterable);
+  char character = string->string[iterator->index];
+  if (!character)
+    return false;
+
+  iterator->index++;
+  *element = Value_fromObject((Object *)wsky_String_getCharacter(character));
+  return true;
+}
+
+bool wsky_Iterator_next(Iterator *iterator, Value *element) {
+  if (wsky_isString(iterator->iterable))
+    return nextCharacter(iterator, element);
+
+  if (iterator->index >= Value_getInt(iterator->iterable))
+    return false;
+
+  *element = Value_fromInt(iterator->index++);
+  return true;
+}
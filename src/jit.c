@@ -0,0 +1,600 @@
+/* The templates read the tag and the payload of the tagged values */
+#if defined(__x86_64__) && defined(__linux__) && !defined(WSKY_NAN_BOXING)
+# define _DEFAULT_SOURCE
+# include <sys/mman.h>
+# include <unistd.h>
+# define JIT_SUPPORTED 1
+#else
+# define JIT_SUPPORTED 0
+#endif
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vm_private.h"
+
+
+/** -1 until the environment is read */
+static int enabled = -1;
+
+static unsigned threshold = wsky_jit_DEFAULT_THRESHOLD;
+
+
+bool wsky_jit_isEnabled(void) {
+  if (enabled < 0)
+    enabled = JIT_SUPPORTED && !getenv("WSKY_NO_JIT");
+  return enabled;
+}
+
+void wsky_jit_setEnabled(bool newEnabled) {
+  enabled = JIT_SUPPORTED && newEnabled;
+}
+
+unsigned wsky_jit_getThreshold(void) {
+  return threshold;
+}
+
+void wsky_jit_setThreshold(unsigned runCount) {
+  threshold = runCount;
+}
+
+
+
+#if JIT_SUPPORTED
+
+/** The registers used by the templates */
+typedef enum {
+  RAX = 0,
+  RCX = 1,
+  RDX = 2,
+
+  /** Holds the VMState during the whole function */
+  RBX = 3,
+} Register;
+
+/** The condition codes of Jcc and SETcc */
+typedef enum {
+  Condition_O = 0x0,
+  Condition_E = 0x4,
+  Condition_NE = 0x5,
+  Condition_L = 0xc,
+  Condition_GE = 0xd,
+  Condition_LE = 0xe,
+  Condition_G = 0xf,
+} Condition;
+
+/** The label of the error exit, for the jumps */
+#define ERROR_LABEL (-1)
+
+/** A jump whose target is not known yet */
+typedef struct {
+  /** The offset of the 32 bits displacement to patch */
+  size_t position;
+
+  /** The index of the target instruction, or ERROR_LABEL */
+  int target;
+} Fixup;
+
+typedef struct {
+  const Code *code;
+
+  uint8_t *bytes;
+  size_t size;
+  size_t capacity;
+
+  /** The offset of each instruction, indexed by instruction index / 2 */
+  size_t *labels;
+
+  Fixup *fixups;
+  size_t fixupCount;
+  size_t fixupCapacity;
+} Assembler;
+
+
+/** The displacements from the top of the operand stack */
+#define VALUE(index) ((int)(sizeof(Value) * (index)))
+#define TYPE(index) (VALUE(index) + (int)offsetof(Value, type))
+
+#define STATE(field) ((int)offsetof(VMState, field))
+#define SCOPE(field) ((int)offsetof(Scope, field))
+
+
+static void *grow(void *array, size_t *capacity, size_t size,
+                  size_t itemSize) {
+  if (size <= *capacity)
+    return array;
+  while (*capacity < size)
+    *capacity = *capacity ? *capacity * 2 : 256;
+  array = wsky_realloc(array, *capacity * itemSize);
+  if (!array)
+    abort();
+  return array;
+}
+
+static void emitBytes(Assembler *a, const void *bytes, size_t count) {
+  a->bytes = grow(a->bytes, &a->capacity, a->size + count, 1);
+  memcpy(a->bytes + a->size, bytes, count);
+  a->size += count;
+}
+
+static void emit(Assembler *a, uint8_t byte) {
+  emitBytes(a, &byte, 1);
+}
+
+static void emit32(Assembler *a, int32_t value) {
+  emitBytes(a, &value, 4);
+}
+
+/** Emits the ModRM byte and the displacement of `[base + disp]` */
+static void emitMemory(Assembler *a, int reg, Register base, int disp) {
+  if (disp >= -128 && disp <= 127) {
+    emit(a, (uint8_t)(0x40 | reg << 3 | base));
+    emit(a, (uint8_t)disp);
+  } else {
+    emit(a, (uint8_t)(0x80 | reg << 3 | base));
+    emit32(a, disp);
+  }
+}
+
+/** `mov reg, [base + disp]` */
+static void emitLoad(Assembler *a, Register reg, Register base, int disp) {
+  emit(a, 0x48);
+  emit(a, 0x8b);
+  emitMemory(a, reg, base, disp);
+}
+
+/** `mov [base + disp], reg` */
+static void emitStore(Assembler *a, Register base, int disp, Register reg) {
+  emit(a, 0x48);
+  emit(a, 0x89);
+  emitMemory(a, reg, base, disp);
+}
+
+/** `op rax, [base + disp]`, with op being add, sub or cmp */
+static void emitArithmetic(Assembler *a, uint8_t opcode,
+                           Register base, int disp) {
+  emit(a, 0x48);
+  emit(a, opcode);
+  emitMemory(a, RAX, base, disp);
+}
+
+/** `cmp dword [base + disp], imm8` */
+static void emitCompareDword(Assembler *a, Register base, int disp,
+                             int8_t value) {
+  emit(a, 0x83);
+  emitMemory(a, 7, base, disp);
+  emit(a, (uint8_t)value);
+}
+
+/** `cmp byte [base + disp], imm8` */
+static void emitCompareByte(Assembler *a, Register base, int disp,
+                            int8_t value) {
+  emit(a, 0x80);
+  emitMemory(a, 7, base, disp);
+  emit(a, (uint8_t)value);
+}
+
+/** `mov dword [base + disp], imm32` */
+static void emitStoreDword(Assembler *a, Register base, int disp,
+                           int32_t value) {
+  emit(a, 0xc7);
+  emitMemory(a, 0, base, disp);
+  emit32(a, value);
+}
+
+/** `add qword [rbx + disp], imm8` */
+static void emitAddToState(Assembler *a, int disp, int8_t value) {
+  emit(a, 0x48);
+  emit(a, 0x83);
+  emitMemory(a, 0, RBX, disp);
+  emit(a, (uint8_t)value);
+}
+
+/** `movsd xmm0, [base + disp]` or `op xmm0, [base + disp]` */
+static void emitSse(Assembler *a, uint8_t opcode, Register base, int disp) {
+  emit(a, 0xf2);
+  emit(a, 0x0f);
+  emit(a, opcode);
+  emitMemory(a, 0, base, disp);
+}
+
+/** `mov rax, imm64` */
+static void emitLoadImmediate(Assembler *a, const void *value) {
+  emit(a, 0x48);
+  emit(a, 0xb8);
+  emitBytes(a, value, 8);
+}
+
+/** `jcc rel32`, returns the position of the displacement */
+static size_t emitJumpIf(Assembler *a, Condition condition) {
+  emit(a, 0x0f);
+  emit(a, (uint8_t)(0x80 | condition));
+  emit32(a, 0);
+  return a->size - 4;
+}
+
+/** `jmp rel32`, returns the position of the displacement */
+static size_t emitJump(Assembler *a) {
+  emit(a, 0xe9);
+  emit32(a, 0);
+  return a->size - 4;
+}
+
+/** Sets the displacement of a jump to the current position */
+static void patchJump(Assembler *a, size_t position) {
+  int32_t displacement = (int32_t)(a->size - (position + 4));
+  memcpy(a->bytes + position, &displacement, 4);
+}
+
+/** Makes a jump go to an instruction, or to the error exit */
+static void addFixup(Assembler *a, size_t position, int target) {
+  a->fixups = grow(a->fixups, &a->fixupCapacity, a->fixupCount + 1,
+                   sizeof(Fixup));
+  a->fixups[a->fixupCount++] = (Fixup) {position, target};
+}
+
+
+
+/** Calls the instruction of the virtual machine */
+static void emitCall(Assembler *a, Opcode opcode, int operand) {
+  VMInstruction instruction = wsky_vm_INSTRUCTIONS[opcode];
+
+  /* mov rdi, rbx */
+  emitBytes(a, "\x48\x89\xdf", 3);
+  /* mov esi, operand */
+  emit(a, 0xbe);
+  emit32(a, operand);
+  emitLoadImmediate(a, &instruction);
+  /* call rax */
+  emitBytes(a, "\xff\xd0", 2);
+}
+
+/** Calls an instruction which only continues or raises */
+static void emitGeneric(Assembler *a, Opcode opcode, int operand) {
+  emitCall(a, opcode, operand);
+  /* test eax, eax */
+  emitBytes(a, "\x85\xc0", 2);
+  addFixup(a, emitJumpIf(a, Condition_NE), ERROR_LABEL);
+}
+
+/** Pushes a value known at compile time */
+static void emitPush(Assembler *a, Value value) {
+  emitLoadImmediate(a, &value.v);
+  emitLoad(a, RCX, RBX, STATE(sp));
+  emitStore(a, RCX, VALUE(0), RAX);
+  emitStoreDword(a, RCX, TYPE(0), (int32_t)value.type);
+  emitAddToState(a, STATE(sp), (int8_t)sizeof(Value));
+}
+
+/** Copies a value from `[from + fromDisp]` to `[to + toDisp]` with rdx */
+static void emitCopyValue(Assembler *a, Register to, int toDisp,
+                          Register from, int fromDisp) {
+  for (int i = 0; i < (int)sizeof(Value); i += 8) {
+    emitLoad(a, RDX, from, fromDisp + i);
+    emitStore(a, to, toDisp + i, RDX);
+  }
+}
+
+
+/**
+ * Loads the address of the slots of a resolved variable in rax.
+ * Jumps to the returned position if the variable is not declared.
+ */
+static size_t emitSlotsAddress(Assembler *a, LexicalAddress address) {
+  emitLoad(a, RDX, RBX, STATE(scope));
+  for (int i = 0; i < address.depth; i++)
+    emitLoad(a, RDX, RDX, SCOPE(parent));
+  emitLoad(a, RAX, RDX, SCOPE(declared));
+  emitCompareByte(a, RAX, address.slot, 0);
+  size_t notDeclared = emitJumpIf(a, Condition_E);
+  emitLoad(a, RAX, RDX, SCOPE(slots));
+  return notDeclared;
+}
+
+static void emitVariable(Assembler *a, Opcode opcode, int operand) {
+  const IdentifierNode *node;
+  node = (const IdentifierNode *)a->code->nodes[operand];
+  if (!wsky_LexicalAddress_isResolved(node->address)) {
+    emitGeneric(a, opcode, operand);
+    return;
+  }
+
+  int slot = VALUE(node->address.slot);
+  size_t slow = emitSlotsAddress(a, node->address);
+  emitLoad(a, RCX, RBX, STATE(sp));
+  if (opcode == wsky_Opcode_LOAD_VARIABLE) {
+    emitCopyValue(a, RCX, VALUE(0), RAX, slot);
+    emitAddToState(a, STATE(sp), (int8_t)sizeof(Value));
+  } else {
+    emitCopyValue(a, RAX, slot, RCX, VALUE(-1));
+  }
+  size_t done = emitJump(a);
+
+  patchJump(a, slow);
+  emitGeneric(a, opcode, operand);
+  patchJump(a, done);
+}
+
+
+static bool getIntCondition(Operator operator, Condition *condition) {
+  switch (operator) {
+  case wsky_Operator_LT: *condition = Condition_L; return true;
+  case wsky_Operator_GT: *condition = Condition_G; return true;
+  case wsky_Operator_LT_EQ: *condition = Condition_LE; return true;
+  case wsky_Operator_GT_EQ: *condition = Condition_GE; return true;
+  case wsky_Operator_EQUALS: *condition = Condition_E; return true;
+  case wsky_Operator_NOT_EQUALS: *condition = Condition_NE; return true;
+  default: return false;
+  }
+}
+
+/** Returns the opcode of the SSE instruction, or 0 */
+static uint8_t getFloatOpcode(Operator operator) {
+  switch (operator) {
+  case wsky_Operator_PLUS: return 0x58;
+  case wsky_Operator_MINUS: return 0x5c;
+  case wsky_Operator_STAR: return 0x59;
+  default: return 0;
+  }
+}
+
+static bool hasInlineOperation(Type type, Operator operator) {
+  Condition condition;
+  if (type == wsky_Type_FLOAT)
+    return getFloatOpcode(operator) != 0;
+  return operator == wsky_Operator_PLUS || operator == wsky_Operator_MINUS ||
+    getIntCondition(operator, &condition);
+}
+
+/**
+ * Replaces the two integers at rcx - 32 and rcx - 16 with the result.
+ * Returns the position of the jump taken if the result overflows,
+ * before the operands are replaced, or 0 if it cannot overflow.
+ */
+static size_t emitIntOperation(Assembler *a, Operator operator) {
+  Condition condition;
+  size_t overflow = 0;
+  emitLoad(a, RAX, RCX, VALUE(-2));
+  if (getIntCondition(operator, &condition)) {
+    emitArithmetic(a, 0x3b, RCX, VALUE(-1));
+    /* setcc al; movzx eax, al */
+    emit(a, 0x0f);
+    emit(a, (uint8_t)(0x90 | condition));
+    emit(a, 0xc0);
+    emitBytes(a, "\x0f\xb6\xc0", 3);
+    emitStoreDword(a, RCX, TYPE(-2), wsky_Type_BOOL);
+  } else {
+    emitArithmetic(a, operator == wsky_Operator_PLUS ? 0x03 : 0x2b,
+                   RCX, VALUE(-1));
+    /* The evaluator gives a Float */
+    overflow = emitJumpIf(a, Condition_O);
+  }
+  emitStore(a, RCX, VALUE(-2), RAX);
+  return overflow;
+}
+
+/** Replaces the two floats at rcx - 32 and rcx - 16 with the result */
+static void emitFloatOperation(Assembler *a, Operator operator) {
+  emitSse(a, 0x10, RCX, VALUE(-2));
+  emitSse(a, getFloatOpcode(operator), RCX, VALUE(-1));
+  emitSse(a, 0x11, RCX, VALUE(-2));
+}
+
+/**
+ * Tries the inline operation on integers, then on floats, and calls
+ * the instruction of the virtual machine for the other values.
+ */
+static void emitBinaryOperator(Assembler *a, int operand) {
+  const OperatorNode *node = (const OperatorNode *)a->code->nodes[operand];
+  static const Type types[] = {wsky_Type_INT, wsky_Type_FLOAT};
+
+  size_t slowJumps[3];
+  unsigned slowJumpCount = 0;
+  size_t doneJumps[2];
+  unsigned doneJumpCount = 0;
+
+  for (unsigned i = 0; i < 2; i++) {
+    Type type = types[i];
+    if (!hasInlineOperation(type, node->operator))
+      continue;
+
+    while (slowJumpCount)
+      patchJump(a, slowJumps[--slowJumpCount]);
+
+    emitLoad(a, RCX, RBX, STATE(sp));
+    emitCompareDword(a, RCX, TYPE(-2), (int8_t)type);
+    slowJumps[slowJumpCount++] = emitJumpIf(a, Condition_NE);
+    emitCompareDword(a, RCX, TYPE(-1), (int8_t)type);
+    slowJumps[slowJumpCount++] = emitJumpIf(a, Condition_NE);
+
+    if (type == wsky_Type_INT) {
+      size_t overflow = emitIntOperation(a, node->operator);
+      if (overflow)
+        slowJumps[slowJumpCount++] = overflow;
+    } else {
+      emitFloatOperation(a, node->operator);
+    }
+    emitAddToState(a, STATE(sp), (int8_t)-(int)sizeof(Value));
+    doneJumps[doneJumpCount++] = emitJump(a);
+  }
+
+  while (slowJumpCount)
+    patchJump(a, slowJumps[--slowJumpCount]);
+  emitGeneric(a, wsky_Opcode_BINARY_OPERATOR, operand);
+  while (doneJumpCount)
+    patchJump(a, doneJumps[--doneJumpCount]);
+}
+
+
+/** Pops a boolean, and jumps if it is false */
+static void emitJumpIfFalse(Assembler *a, int target) {
+  emitLoad(a, RCX, RBX, STATE(sp));
+  emitCompareDword(a, RCX, TYPE(-1), wsky_Type_BOOL);
+  size_t slow = emitJumpIf(a, Condition_NE);
+  emitAddToState(a, STATE(sp), (int8_t)-(int)sizeof(Value));
+  emitCompareByte(a, RCX, VALUE(-1), 0);
+  addFixup(a, emitJumpIf(a, Condition_E), target);
+  size_t done = emitJump(a);
+
+  /* Raises the TypeError */
+  patchJump(a, slow);
+  emitGeneric(a, wsky_Opcode_JUMP_IF_FALSE, target);
+  patchJump(a, done);
+}
+
+static void emitReturn(Assembler *a) {
+  emitCall(a, wsky_Opcode_RETURN, 0);
+  /* pop rbx; ret */
+  emitBytes(a, "\x5b\xc3", 2);
+}
+
+
+static void emitInstruction(Assembler *a, Opcode opcode, int operand) {
+  switch (opcode) {
+  case wsky_Opcode_PUSH_NULL:
+    emitPush(a, Value_NULL);
+    break;
+
+  case wsky_Opcode_PUSH_TRUE:
+    emitPush(a, Value_TRUE);
+    break;
+
+  case wsky_Opcode_PUSH_FALSE:
+    emitPush(a, Value_FALSE);
+    break;
+
+  case wsky_Opcode_PUSH_CONSTANT:
+    emitPush(a, a->code->constants[operand]);
+    break;
+
+  case wsky_Opcode_LOAD_VARIABLE:
+  case wsky_Opcode_STORE_VARIABLE:
+    emitVariable(a, opcode, operand);
+    break;
+
+  case wsky_Opcode_POP:
+    emitAddToState(a, STATE(sp), (int8_t)-(int)sizeof(Value));
+    break;
+
+  case wsky_Opcode_BINARY_OPERATOR:
+    emitBinaryOperator(a, operand);
+    break;
+
+  case wsky_Opcode_JUMP:
+    addFixup(a, emitJump(a), operand);
+    break;
+
+  case wsky_Opcode_JUMP_IF_FALSE:
+    emitJumpIfFalse(a, operand);
+    break;
+
+  case wsky_Opcode_RETURN:
+    emitReturn(a);
+    break;
+
+  default:
+    emitGeneric(a, opcode, operand);
+  }
+}
+
+
+static void assemble(Assembler *a) {
+  const Code *code = a->code;
+
+  /* push rbx; mov rbx, rdi */
+  emitBytes(a, "\x53\x48\x89\xfb", 4);
+
+  for (unsigned i = 0; i < code->instructionCount; i += 2) {
+    a->labels[i / 2] = a->size;
+    emitInstruction(a, (Opcode)code->instructions[i],
+                    code->instructions[i + 1]);
+  }
+
+  size_t errorLabel = a->size;
+  /* mov eax, VMStatus_ERROR; pop rbx; ret */
+  emit(a, 0xb8);
+  emit32(a, VMStatus_ERROR);
+  emitBytes(a, "\x5b\xc3", 2);
+
+  for (size_t i = 0; i < a->fixupCount; i++) {
+    Fixup fixup = a->fixups[i];
+    size_t target = fixup.target == ERROR_LABEL ?
+      errorLabel : a->labels[fixup.target / 2];
+    int32_t displacement = (int32_t)(target - (fixup.position + 4));
+    memcpy(a->bytes + fixup.position, &displacement, 4);
+  }
+}
+
+
+bool wsky_jit_compile(Code *code) {
+  assert(!code->machineCode);
+
+  /* The templates are written for this layout of the values */
+  if (!wsky_jit_isEnabled() || sizeof(Value) != 16 || sizeof(Type) != 4)
+    return false;
+
+  Assembler a = {code, NULL, 0, 0, NULL, NULL, 0, 0};
+  a.labels = wsky_safeMalloc(sizeof(size_t) * (code->instructionCount / 2));
+  assemble(&a);
+
+  long pageSize = sysconf(_SC_PAGESIZE);
+  size_t size = (a.size + (size_t)pageSize - 1) & ~((size_t)pageSize - 1);
+
+  void *memory = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (memory != MAP_FAILED) {
+    memcpy(memory, a.bytes, a.size);
+    if (mprotect(memory, size, PROT_READ | PROT_EXEC)) {
+      munmap(memory, size);
+      memory = MAP_FAILED;
+    }
+  }
+
+  wsky_free(a.bytes);
+  wsky_free(a.labels);
+  wsky_free(a.fixups);
+
+  if (memory == MAP_FAILED) {
+    /* Don't try again */
+    wsky_jit_setEnabled(false);
+    return false;
+  }
+
+  code->machineCode = memory;
+  code->machineCodeSize = size;
+  return true;
+}
+
+void wsky_jit_free(Code *code) {
+  if (code->machineCode)
+    munmap(code->machineCode, code->machineCodeSize);
+  code->machineCode = NULL;
+}
+
+VMStatus wsky_jit_run(const Code *code, VMState *state) {
+  VMStatus (*function)(VMState *state);
+  /* ISO C has no conversion from object pointers to function pointers */
+  memcpy(&function, &code->machineCode, sizeof(function));
+  return function(state);
+}
+
+
+#else /* !JIT_SUPPORTED */
+
+bool wsky_jit_compile(Code *code) {
+  (void)code;
+  return false;
+}
+
+void wsky_jit_free(Code *code) {
+  (void)code;
+}
+
+VMStatus wsky_jit_run(const Code *code, VMState *state) {
+  (void)code;
+  (void)state;
+  abort();
+}
+
+#endif
@@ -416,6 +416,10 @@ static Result parseNumber(StringReader *reader,
   wsky_int v = parseUintBase(string, baseChars);
   if (v == -1)
     return createErrorResult("Invalid number", begin);
+#ifdef WSKY_NAN_BOXING
+  if (v > wsky_Value_INT_MAX)
+    return createErrorResult("Too big integer", begin);
+#endif
   return createIntTokenResult(reader, begin, v);
 }
 
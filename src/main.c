@@ -1,13 +1,51 @@
+#include <string.h>
 #include "whiskey_private.h"
 
 
+static int runFile(const char *filePath, wsky_Engine engine) {
+  wsky_startWithEngine(engine);
+
+  int status = 0;
+  ReturnValue rv = wsky_evalFile(filePath);
+  if (!rv.exception)
+    rv = wsky_toString(rv.v);
+
+  if (rv.exception) {
+    wsky_Exception_print(rv.exception);
+    status = 1;
+  } else {
+    printf("%s\n", ((String *)Value_getObject(rv.v))->string);
+  }
+
+  wsky_stop();
+  return status;
+}
+
+
 int main(int argc, char **argv)
 {
-  (void) argc;
-  (void) argv;
+  wsky_Engine engine = wsky_Engine_AST;
+
+  if (argc > 1 && strcmp(argv[1], "--bytecode") == 0) {
+    engine = wsky_Engine_BYTECODE;
+    argc--;
+    argv++;
+  } else if (argc > 1 && strcmp(argv[1], "--jit") == 0) {
+    engine = wsky_Engine_JIT;
+    argc--;
+    argv++;
+  }
+
+  if (argc > 2) {
+    fprintf(stderr, "Usage: whiskey [--bytecode | --jit] [file]\n");
+    return 2;
+  }
+
+  if (argc == 2)
+    return runFile(argv[1], engine);
 
   printf("Whiskey\n");
 
-  wsky_repl(true);
+  wsky_repl(true, engine);
   return 0;
 }
@@ -3,57 +3,67 @@
 #include "whiskey_private.h"
 
 
+/*
+ * The trampolines cast the C function of a method to its type and call
+ * it. The parameters are given in place, from the array of the caller.
+ */
+typedef ReturnValue (*Trampoline)(wsky_Method0 function, Object *self,
+                                  unsigned parameterCount,
+                                  const Value *parameters);
+
+/* The methods take non-const pointers, but never write the parameters */
+#define P(i) ((Value *)parameters + (i))
+
+#define TRAMPOLINE(count, arguments)                                    \
+  static ReturnValue call ## count(wsky_Method0 function, Object *self, \
+                                   unsigned parameterCount,             \
+                                   const Value *parameters) {           \
+    (void)parameterCount;                                               \
+    (void)parameters;                                                   \
+    return ((wsky_Method ## count)function) arguments;                  \
+  }
+
+TRAMPOLINE(0, (self))
+TRAMPOLINE(1, (self, P(0)))
+TRAMPOLINE(2, (self, P(0), P(1)))
+TRAMPOLINE(3, (self, P(0), P(1), P(2)))
+TRAMPOLINE(4, (self, P(0), P(1), P(2), P(3)))
+TRAMPOLINE(5, (self, P(0), P(1), P(2), P(3), P(4)))
+
+#undef TRAMPOLINE
+#undef P
+
+static ReturnValue callVariadic(wsky_Method0 function, Object *self,
+                                unsigned parameterCount,
+                                const Value *parameters) {
+  return ((wsky_VariadicMethod)function)(self, parameterCount, parameters);
+}
+
+/* The trampolines, indexed by the parameter count plus one */
+static const Trampoline TRAMPOLINES[] = {
+  callVariadic,
+  call0, call1, call2, call3, call4, call5,
+};
+
+#define MAX_PARAMETER_COUNT 5
+
+
 static ReturnValue wsky_MethodDef_callImpl(const MethodDef *method,
                                            Object *object,
                                            unsigned parameterCount,
-                                           const Value *constParams) {
-  Value parameters[64];
-  memcpy(parameters, constParams, sizeof(Value) * parameterCount);
-
-  wsky_Method0 m = (wsky_Method0)method->function;
-
-  if (method->parameterCount == -1) {
-    return ((wsky_VariadicMethod) m)(object,
-                                     parameterCount,
-                                     parameters);
-  } else {
-    if ((int) parameterCount != method->parameterCount) {
-      RAISE_NEW_PARAMETER_ERROR("Invalid parameter count");
-    }
+                                           const Value *parameters) {
+  int expectedCount = method->parameterCount;
+  if (expectedCount != -1 && (int) parameterCount != expectedCount) {
+    RAISE_NEW_PARAMETER_ERROR("Invalid parameter count");
   }
 
-  switch (method->parameterCount) {
-  case 0:
-    return ((wsky_Method0) m)(object);
-  case 1:
-    return ((wsky_Method1) m)(object,
-                              parameters);
-  case 2:
-    return ((wsky_Method2) m)(object,
-                              parameters,
-                              parameters + 1);
-  case 3:
-    return ((wsky_Method3) m)(object,
-                              parameters,
-                              parameters + 1,
-                              parameters + 2);
-  case 4:
-    return ((wsky_Method4) m)(object,
-                              parameters,
-                              parameters + 1,
-                              parameters + 2,
-                              parameters + 3);
-  case 5:
-    return ((wsky_Method5) m)(object,
-                              parameters,
-                              parameters + 1,
-                              parameters + 2,
-                              parameters + 3,
-                              parameters + 4);
-  default:
+  if (expectedCount > MAX_PARAMETER_COUNT) {
     fprintf(stderr, "wsky_Method_call(): Too many parameters\n");
     abort();
   }
+
+  Trampoline trampoline = TRAMPOLINES[expectedCount + 1];
+  return trampoline(method->function, object, parameterCount, parameters);
 }
 
 
@@ -10,10 +10,10 @@ Module *wsky_MATH_MODULE;
 static ReturnValue valueToFloat(Value value, wsky_float *result) {
   *result = 0.0f;
   if (wsky_isFloat(value)) {
-    *result = value.v.floatValue;
+    *result = Value_getFloat(value);
     RETURN_NULL;
   } else if (wsky_isInteger(value)) {
-    *result = value.v.intValue;
+    *result = Value_getInt(value);
     RETURN_NULL;
   }
   RAISE_NEW_PARAMETER_ERROR("Expected a number");
@@ -57,7 +57,7 @@ static ReturnValue max(Object *self,
                                             largest);
     if (rv.exception)
       return rv;
-    if (wsky_isBoolean(rv.v) && rv.v.v.boolValue)
+    if (wsky_isBoolean(rv.v) && Value_getBool(rv.v))
       largest = value;
   }
 
@@ -80,7 +80,7 @@ static ReturnValue min(Object *self,
                                             smallest);
     if (rv.exception)
       return rv;
-    if (wsky_isBoolean(rv.v) && rv.v.v.boolValue)
+    if (wsky_isBoolean(rv.v) && Value_getBool(rv.v))
       smallest = value;
   }
 
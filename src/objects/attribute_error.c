@@ -34,7 +34,7 @@ AttributeError *wsky_AttributeError_new(const char *message) {
   r = wsky_Object_new(wsky_AttributeError_CLASS, 1, &v);
   if (r.exception)
     abort();
-  return (AttributeError *) r.v.v.objectValue;
+  return (AttributeError *) Value_getObject(r.v);
 }
 
 AttributeError *wsky_AttributeError_newNoAttr(const char *className,
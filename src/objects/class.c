@@ -69,24 +69,313 @@ static inline bool isConstructor(MethodFlags flags) {
 }
 
 
+#define OPERATOR_PREFIX "operator "
+
+/*
+ * The methods of the builtin classes are created on their first lookup,
+ * except the operators and the setters, which are stored in the tables
+ * of the class at its creation. Until then, their entries in the static
+ * tables of the classes are PENDING_METHOD.
+ */
+static Method pendingMethod;
+#define PENDING_METHOD (&pendingMethod)
+
+
+/*
+ * Returns the entry of a selector in a table, or the empty entry where
+ * it would be added. The table is never more than half full, so the
+ * probing ends on an empty entry.
+ */
+static MethodTableEntry *findEntry(const MethodTable *table,
+                                   unsigned selector) {
+  unsigned i = selector & table->mask;
+  while (table->entries[i].selector >= 0 &&
+         table->entries[i].selector != (int)selector)
+    i = (i + 1) & table->mask;
+  return table->entries + i;
+}
+
+static void setInTable(MethodTable *table, unsigned selector,
+                       Method *method) {
+  MethodTableEntry *entry = findEntry(table, selector);
+  if (entry->selector < 0) {
+    entry->selector = (int)selector;
+    table->count++;
+  }
+  entry->method = method;
+}
+
+/*
+ * Returns the slot of a selector in the methods of a finalized class, or
+ * NULL. The static table of a builtin class is indexed by selector, and
+ * has no other selector than the builtin ones.
+ */
+static Method **findMethodSlot(Class *class, unsigned selector) {
+  if (!class->builtinTable)
+    return &findEntry(&class->vtable, selector)->method;
+  if (selector >= wsky_Selector_BUILTIN_COUNT)
+    return NULL;
+  return class->builtinTable->methods + selector;
+}
+
+/* Interns the name of a method, which is a builtin one in a builtin class */
+static void internName(const Class *class, const char *name) {
+  unsigned selector = wsky_selector_intern(name);
+  if (class->builtinTable && selector >= wsky_Selector_BUILTIN_COUNT) {
+    fprintf(stderr, "Not a builtin selector: %s.%s\n", class->name, name);
+    abort();
+  }
+}
+
+static bool isPending(const MethodDef *def) {
+  return !isSetter(def->flags) &&
+    strncmp(def->name, OPERATOR_PREFIX, strlen(OPERATOR_PREFIX)) != 0;
+}
+
 void wsky_Class_initMethods(Class *class, const ClassDef *def) {
-  MethodDef *methodDef = def->methodDefs;
+  assert(!class->finalized);
+  class->methodDefs = def->methodDefs;
 
-  while (methodDef->name) {
-    Method* method = wsky_Method_newFromC(methodDef, class);
-    if (isConstructor(method->flags))
+  for (const MethodDef *methodDef = def->methodDefs; methodDef->name;
+       methodDef++) {
+    if (isConstructor(methodDef->flags))
       abort();
 
-    if (isSetter(method->flags))
-      wsky_Dict_set(class->setters, method->name, method);
+    if (isPending(methodDef))
+      internName(class, methodDef->name);
     else
-      wsky_Dict_set(class->methods, method->name, method);
-    methodDef++;
+      wsky_Class_addMethod(class, wsky_Method_newFromC(methodDef, class));
+  }
+}
+
+/* Creates a pending method of the class, or returns NULL */
+static Method *createPendingMethod(Class *class, const char *name) {
+  for (const MethodDef *def = class->methodDefs; def->name; def++) {
+    if (!isPending(def) || strcmp(def->name, name) != 0)
+      continue;
+
+    Method *method = wsky_Method_newFromC(def, class);
+    wsky_Dict_set(class->methods, def->name, method);
+    if (class->finalized)
+      *findMethodSlot(class, (unsigned)wsky_selector_find(def->name)) = method;
+    return method;
+  }
+  return NULL;
+}
+
+
+/*
+ * Returns the slot of the operator table where an operator method
+ * is stored, or NULL if the name is not an operator name.
+ * The names are like "operator +" or "operator r+".
+ */
+static Method **getOperatorSlot(OperatorTable *table, const char *name) {
+  size_t prefixLength = strlen(OPERATOR_PREFIX);
+  if (strncmp(name, OPERATOR_PREFIX, prefixLength) != 0)
+    return NULL;
+  name += prefixLength;
+
+  Method **slots = table->binary;
+  if (*name == 'r') {
+    slots = table->reversed;
+    name++;
+  }
+
+  for (int i = 0; i < wsky_Operator_COUNT; i++) {
+    if (strcmp(name, wsky_Operator_toString((Operator)i)) == 0)
+      return slots + i;
+  }
+  return NULL;
+}
+
+#undef OPERATOR_PREFIX
+
+void wsky_Class_addMethod(Class *class, Method *method) {
+  assert(!isConstructor(method->flags));
+  assert(!class->finalized);
+  internName(class, method->name);
+
+  if (isSetter(method->flags)) {
+    wsky_Dict_set(class->setters, method->name, method);
+    return;
+  }
+
+  wsky_Dict_set(class->methods, method->name, method);
+
+  Method **slot = getOperatorSlot(class->operators, method->name);
+  if (slot)
+    *slot = method;
+}
+
+static void inheritOperatorSlots(Method **slots, Method **superSlots) {
+  for (int i = 0; i < wsky_Operator_COUNT; i++) {
+    if (!slots[i])
+      slots[i] = superSlots[i];
+  }
+}
+
+/*
+ * Fills the missing operators of the class with the ones of its
+ * superclasses, which may have got operators after the creation of
+ * the class, like the builtin classes.
+ */
+static void inheritOperators(Class *class) {
+  OperatorTable *table = class->operators;
+  for (Class *super = class->super; super; super = super->super) {
+    OperatorTable *superTable = super->operators;
+    inheritOperatorSlots(table->binary, superTable->binary);
+    inheritOperatorSlots(table->reversed, superTable->reversed);
+  }
+}
+
+static void addToTable(const char *name, void *method, void *table) {
+  setInTable(table, (unsigned)wsky_selector_find(name), method);
+}
+
+static void addToBuiltinTable(const char *name, void *method, void *slots) {
+  ((Method **)slots)[wsky_selector_find(name)] = method;
+}
+
+static void countMethod(const char *name, void *method, void *count) {
+  (void) name;
+  (void) method;
+  (*(unsigned *)count)++;
+}
+
+/* Returns the methods or the setters of the table of a builtin class */
+static Method **getBuiltinSlots(const Class *class, bool setters) {
+  BuiltinMethodTable *table = class->builtinTable;
+  return setters ? table->setters : table->methods;
+}
+
+/*
+ * Builds a copy of the table of the superclass with the given methods.
+ * The superclass may be a builtin class, with a static table.
+ */
+static void buildTable(MethodTable *table, const Class *super,
+                       bool setters, const Dict *methods) {
+  const MethodTable *superTable = NULL;
+  Method **superSlots = NULL;
+  unsigned count = 0;
+  if (super && super->builtinTable) {
+    superSlots = getBuiltinSlots(super, setters);
+    for (unsigned i = 0; i < wsky_Selector_BUILTIN_COUNT; i++) {
+      if (superSlots[i])
+        count++;
+    }
+  } else if (super) {
+    superTable = setters ? &super->setterTable : &super->vtable;
+    count = superTable->count;
+  }
+  wsky_Dict_applyWithData(methods, countMethod, &count);
+
+  unsigned size = 2;
+  while (size < 2 * count)
+    size *= 2;
+  table->entries = wsky_safeMalloc(size * sizeof(MethodTableEntry));
+  for (unsigned i = 0; i < size; i++)
+    table->entries[i] = (MethodTableEntry) {-1, NULL};
+  table->mask = size - 1;
+  table->count = 0;
+
+  if (superSlots) {
+    for (unsigned i = 0; i < wsky_Selector_BUILTIN_COUNT; i++) {
+      if (superSlots[i])
+        setInTable(table, i, superSlots[i]);
+    }
+  }
+  if (superTable) {
+    for (unsigned i = 0; i <= superTable->mask; i++) {
+      const MethodTableEntry *entry = superTable->entries + i;
+      if (entry->selector >= 0)
+        setInTable(table, (unsigned)entry->selector, entry->method);
+    }
+  }
+  wsky_Dict_applyWithData(methods, addToTable, table);
+}
+
+/*
+ * Fills the static table of a builtin class from the one of its
+ * superclass. The methods which are not created yet are PENDING_METHOD.
+ */
+static void buildBuiltinTable(Class *class) {
+  BuiltinMethodTable *table = class->builtinTable;
+  if (class->super)
+    *table = *class->super->builtinTable;
+  else
+    memset(table, 0, sizeof(BuiltinMethodTable));
+
+  for (const MethodDef *def = class->methodDefs; def && def->name; def++) {
+    if (isPending(def))
+      table->methods[wsky_selector_find(def->name)] = PENDING_METHOD;
+  }
+  wsky_Dict_applyWithData(class->methods, addToBuiltinTable, table->methods);
+  wsky_Dict_applyWithData(class->setters, addToBuiltinTable, table->setters);
+}
+
+static void setFieldIndex(const char *name, void *methodVoid,
+                          void *classVoid) {
+  Method *method = (Method *)methodVoid;
+  const Class *class = (const Class *)classVoid;
+  if (!wsky_Method_isDefault(method))
+    return;
+  int index = wsky_ScopeLayout_find(class->fields, name);
+  if (index >= 0)
+    method->fieldIndex = (int)class->fieldBase + index;
+}
+
+/* Gives the default accessors the index of their field in the objects */
+static void compileDefaultAccessors(Class *class) {
+  if (class->native || !class->fields)
+    return;
+  wsky_Dict_applyWithData(class->methods, setFieldIndex, class);
+  wsky_Dict_applyWithData(class->setters, setFieldIndex, class);
+}
+
+/* Builds the display of the class from the one of its superclass */
+static void buildDisplay(Class *class) {
+  Class *super = class->super;
+  class->depth = super ? super->depth + 1 : 0;
+  wsky_free(class->display);
+  class->display = wsky_safeMalloc((class->depth + 1) * sizeof(Class *));
+  if (super)
+    memcpy(class->display, super->display, class->depth * sizeof(Class *));
+  class->display[class->depth] = class;
+}
+
+void wsky_Class_finalize(Class *class) {
+  if (class->finalized)
+    return;
+
+  Class *super = class->super;
+  if (super)
+    wsky_Class_finalize(super);
+
+  buildDisplay(class);
+  inheritOperators(class);
+  compileDefaultAccessors(class);
+
+  /* Every name of the hierarchy is interned */
+  if (class->builtinTable) {
+    buildBuiltinTable(class);
+  } else {
+    buildTable(&class->vtable, super, false, class->methods);
+    buildTable(&class->setterTable, super, true, class->setters);
   }
+  class->finalized = true;
+}
+
+static OperatorTable *newOperatorTable(const Class *super) {
+  OperatorTable *table = wsky_safeMalloc(sizeof(OperatorTable));
+  if (super)
+    *table = *super->operators;
+  else
+    memset(table, 0, sizeof(OperatorTable));
+  return table;
 }
 
 
-Class *wsky_Class_new(const char *name, Class *super) {
+Class *wsky_Class_new(const char *name, Class *super, ScopeLayout *fields) {
   if (super)
     assert(!super->final);
 
@@ -100,24 +389,37 @@ Class *wsky_Class_new(const char *name, Class *super) {
   class->native = false;
   class->final = false;
   class->super = super;
+  class->display = NULL;
+  buildDisplay(class);
   class->gcAcceptFunction = NULL;
   class->destructor = NULL;
 
   class->methods = wsky_Dict_new();
   class->setters = wsky_Dict_new();
   class->constructor = NULL;
+  class->operators = newOperatorTable(super);
+  class->vtable.entries = NULL;
+  class->setterTable.entries = NULL;
+  class->builtinTable = NULL;
+  class->finalized = false;
+  class->methodDefs = NULL;
+
+  class->fields = wsky_ScopeLayout_retain(fields);
+  class->fieldBase = super ? wsky_Class_getFieldCount(super) : 0;
 
   class->_initialized = true;
   return class;
 }
 
 
-Class *wsky_Class_newFromC(const ClassDef *def, Class *super) {
-  Class *class = wsky_Class_new(def->name, super);
+Class *wsky_Class_newFromC(const ClassDef *def, Class *super,
+                           BuiltinMethodTable *table) {
+  Class *class = wsky_Class_new(def->name, super, NULL);
   if (!class)
     return NULL;
 
   class->native = true;
+  class->builtinTable = table;
   class->super = super;
   class->final = def->final;
   class->gcAcceptFunction = def->gcAcceptFunction;
@@ -157,6 +459,11 @@ static ReturnValue destroy(Object *object) {
   wsky_free(self->name);
   wsky_Dict_delete(self->methods);
   wsky_Dict_delete(self->setters);
+  wsky_free(self->operators);
+  wsky_free(self->vtable.entries);
+  wsky_free(self->setterTable.entries);
+  wsky_free(self->display);
+  wsky_ScopeLayout_release(self->fields);
   RETURN_NULL;
 }
 
@@ -194,10 +501,10 @@ static ReturnValue init(Class *class,
 
   const Value *self_ = parameters;
 
-  if (self_->type != Type_OBJECT)
+  if (Value_getType(*self_) != Type_OBJECT)
     RAISE_NEW_EXCEPTION("Not implemented");
 
-  Object *self = self_->v.objectValue;
+  Object *self = Value_getObject(*self_);
   if (!wsky_Object_isA(self, class))
     RAISE_NEW_TYPE_ERROR("Type error");
 
@@ -215,16 +522,17 @@ static ReturnValue get(Class *class, Value *self_, Value *name_) {
   if (!wsky_isString(*name_))
     RAISE_NEW_PARAMETER_ERROR("The 2nd parameter must be a string");
 
-  const char *name = ((String *)name_->v.objectValue)->string;
+  const char *name = ((String *)Value_getObject(*name_))->string;
 
-  if (self_->type != Type_OBJECT)
+  if (Value_getType(*self_) != Type_OBJECT)
     RAISE_NEW_EXCEPTION("Not implemented");
 
-  Object *self = self_->v.objectValue;
+  Object *self = Value_getObject(*self_);
   if (!self)
     RAISE_NEW_EXCEPTION("Not implemented");
 
-  return wsky_Class_get(class, self, name);
+  MemberName member = wsky_MemberName_fromString(name);
+  return wsky_Class_get(class, self, &member);
 }
 
 static ReturnValue set(Class *class, Value *self_,
@@ -232,16 +540,17 @@ static ReturnValue set(Class *class, Value *self_,
   if (!wsky_isString(*name_))
     RAISE_NEW_PARAMETER_ERROR("The 2nd parameter must be a string");
 
-  const char *name = ((String *)name_->v.objectValue)->string;
+  const char *name = ((String *)Value_getObject(*name_))->string;
 
-  if (self_->type != Type_OBJECT)
+  if (Value_getType(*self_) != Type_OBJECT)
     RAISE_NEW_EXCEPTION("Not implemented");
 
-  Object *self = self_->v.objectValue;
+  Object *self = Value_getObject(*self_);
   if (!self)
     RAISE_NEW_EXCEPTION("Not implemented");
 
-  return wsky_Class_set(class, self, name, *value);
+  MemberName member = wsky_MemberName_fromString(name);
+  return wsky_Class_set(class, self, &member, *value);
 }
 
 
@@ -249,8 +558,15 @@ static ReturnValue set(Class *class, Value *self_,
 void wsky_Class_acceptGC(Object *object) {
   Class *class = object->class;
   wsky_GC_visitObject(class);
-  if (!class->native)
-    wsky_ObjectFields_acceptGc(&object->fields);
+  if (!class->native && object->fields) {
+    unsigned count = wsky_Class_getFieldCount(class);
+    for (unsigned i = 0; i < count; i++)
+      wsky_GC_visitValue(object->fields[i].value);
+  }
+  if (!class->native) {
+    for (DynamicField *f = object->dynamicFields; f; f = f->next)
+      wsky_GC_visitValue(f->field.value);
+  }
   if (class->gcAcceptFunction) {
     class->gcAcceptFunction(object);
   }
@@ -268,42 +584,81 @@ static inline bool isGetter(MethodFlags flags) {
 
 
 
-static ObjectFields *getFields(Class *wantedClass, Object *self) {
-  ObjectFields *fields = &self->fields;
-  Class *class = self->class;
-  while (fields) {
-    assert(!class->native);
-    if (class == wantedClass)
-      return fields;
-    class = class->super;
-    fields = fields->parent;
+static DynamicField *findDynamicField(const Class *class, Object *self,
+                                      const char *name) {
+  for (DynamicField *f = self->dynamicFields; f; f = f->next) {
+    if (f->class == class && strcmp(f->name, name) == 0)
+      return f;
   }
   return NULL;
 }
 
-ReturnValue wsky_Class_getField(Class *class, Object *self,
-                                const char *name) {
+static DynamicField *addDynamicField(Class *class, Object *self,
+                                     const char *name) {
+  DynamicField *f = wsky_safeMalloc(sizeof(DynamicField));
+  f->class = class;
+  f->name = wsky_strdup(name);
+  f->field = (ObjectField) {Value_NULL, false};
+  f->next = self->dynamicFields;
+  self->dynamicFields = f;
+  return f;
+}
+
+/*
+ * Returns a field of the class, or NULL. A field which is not in the
+ * layout of the class is created if `create` is true.
+ */
+static ObjectField *getField(Class *class, Object *self,
+                             const MemberName *member, bool create) {
+  assert(wsky_Object_isA(self, class));
+
+  int slot = member->fieldSlot;
+  if (slot < 0 && class->fields)
+    slot = wsky_ScopeLayout_find(class->fields, member->name);
+  if (slot >= 0) {
+    assert(strcmp(class->fields->names[slot], member->name) == 0);
+    return self->fields + class->fieldBase + slot;
+  }
+
+  DynamicField *f = findDynamicField(class, self, member->name);
+  if (!f && create)
+    f = addDynamicField(class, self, member->name);
+  return f ? &f->field : NULL;
+}
+
+static ReturnValue getFieldValue(Class *class, Object *self,
+                                 const MemberName *member) {
   assert(!class->native);
-  ObjectFields *fields = getFields(class, self);
+  ObjectField *field = getField(class, self, member, false);
 
-  if (fields) {
-    Value *v = wsky_Dict_get(&fields->fields, name);
-    if (v)
-      return ReturnValue_fromValue(*v);
-  }
+  if (field && field->defined)
+    return ReturnValue_fromValue(field->value);
 
   const char *className = wsky_Object_getClassName(self);
-  return wsky_AttributeError_raiseNoAttr(className, name);
+  return wsky_AttributeError_raiseNoAttr(className, member->name);
+}
+
+ReturnValue wsky_Class_getField(Class *class, Object *self,
+                                const char *name) {
+  MemberName member = wsky_MemberName_fromString(name);
+  return getFieldValue(class, self, &member);
 }
 
 ReturnValue wsky_Class_callGetter(Object *self,
                                   Method *method, const char *name) {
   assert(isGetter(method->flags));
 
-  if (wsky_Method_isDefault(method))
+  if (!wsky_Method_isDefault(method))
+    return wsky_Method_call0(method, self);
+
+  if (method->fieldIndex < 0)
     return wsky_Class_getField(method->defClass, self, name);
 
-  return wsky_Method_call0(method, self);
+  const ObjectField *field = self->fields + method->fieldIndex;
+  if (field->defined)
+    return ReturnValue_fromValue(field->value);
+  return wsky_AttributeError_raiseNoAttr(wsky_Object_getClassName(self),
+                                         name);
 }
 
 
@@ -314,53 +669,62 @@ static ReturnValue raiseTypeError(const char *expectedClass,
   RAISE_NEW_TYPE_ERROR(buffer);
 }
 
+/* Finds a method with the selector of the member if it is known */
+static Method *findMethodOfMember(Class *class, const MemberName *member) {
+  if (member->selector < 0)
+    return wsky_Class_findMethodOrGetter(class, member->name);
+  return wsky_Class_findMethodBySelector(class, (unsigned)member->selector);
+}
+
 ReturnValue wsky_Class_get(Class *class, Object *self,
-                           const char *attribute) {
+                           const MemberName *member) {
   if (!wsky_Object_isA(self, class))
     return raiseTypeError(class->name, wsky_Object_getClass(self)->name);
 
-  Method *method = wsky_Class_findMethodOrGetter(class, attribute);
+  Method *method = findMethodOfMember(class, member);
 
   if (!method || !isPublic(method->flags))
-    return wsky_AttributeError_raiseNoAttr(class->name, attribute);
+    return wsky_AttributeError_raiseNoAttr(class->name, member->name);
 
   if (isGetter(method->flags))
-    return wsky_Class_callGetter(self, method, attribute);
+    return wsky_Class_callGetter(self, method, member->name);
 
   Value v = wsky_Value_fromObject(self);
   RETURN_OBJECT((Object *)wsky_InstanceMethod_new(method, v));
 }
 
 ReturnValue wsky_Class_getPrivate(Class *class, Object *self,
-                                  const char *attribute) {
+                                  const MemberName *member) {
   if (!wsky_Object_isA(self, class))
     return raiseTypeError(class->name, wsky_Object_getClass(self)->name);
 
-  Method *method = wsky_Class_findMethodOrGetter(class, attribute);
-  if (method)
-    return wsky_Class_callGetter(self, method, attribute);
+  Method *method = findMethodOfMember(class, member);
+  if (method && isGetter(method->flags))
+    return wsky_Class_callGetter(self, method, member->name);
+
+  if (method) {
+    Value v = wsky_Value_fromObject(self);
+    RETURN_OBJECT((Object *)wsky_InstanceMethod_new(method, v));
+  }
 
-  return wsky_Class_getField(class, self, attribute);
+  return getFieldValue(class, self, member);
 }
 
 
 
-ReturnValue wsky_Class_setField(Class *class, Object *self,
-                                const char *name, Value value) {
+static ReturnValue setFieldValue(Class *class, Object *self,
+                                 const MemberName *member, Value value) {
   assert(!class->native);
-  ObjectFields *fields = getFields(class, self);
-
-  if (fields) {
-    free(wsky_Dict_get(&fields->fields, name));
-
-    Value *mv = malloc(sizeof(Value));
-    *mv = value;
-    wsky_Dict_set(&fields->fields, name, mv);
-    RETURN_VALUE(value);
-  }
+  ObjectField *field = getField(class, self, member, true);
+  field->value = value;
+  field->defined = true;
+  RETURN_VALUE(value);
+}
 
-  const char *className = wsky_Object_getClassName(self);
-  return wsky_AttributeError_raiseNoAttr(className, name);
+ReturnValue wsky_Class_setField(Class *class, Object *self,
+                                const char *name, Value value) {
+  MemberName member = wsky_MemberName_fromString(name);
+  return setFieldValue(class, self, &member, value);
 }
 
 ReturnValue wsky_Class_callSetter(Object *self,
@@ -368,45 +732,62 @@ ReturnValue wsky_Class_callSetter(Object *self,
                                   Value value) {
   assert(isSetter(method->flags));
 
-  if (wsky_Method_isDefault(method))
+  if (!wsky_Method_isDefault(method))
+    return wsky_Method_call1(method, self, value);
+
+  if (method->fieldIndex < 0)
     return wsky_Class_setField(method->defClass, self, name, value);
 
-  return wsky_Method_call1(method, self, value);
+  ObjectField *field = self->fields + method->fieldIndex;
+  field->value = value;
+  field->defined = true;
+  RETURN_VALUE(value);
+}
+
+/* Finds a setter with the selector of the member if it is known */
+static Method *findSetterOfMember(Class *class, const MemberName *member) {
+  if (member->selector < 0)
+    return wsky_Class_findSetter(class, member->name);
+  return wsky_Class_findSetterBySelector(class, (unsigned)member->selector);
 }
 
 ReturnValue wsky_Class_set(Class *class, Object *self,
-                           const char *attribute, Value value) {
+                           const MemberName *member, Value value) {
   if (!wsky_Object_isA(self, class))
     return raiseTypeError(class->name, wsky_Object_getClass(self)->name);
 
-  Method *method = wsky_Class_findSetter(class, attribute);
+  Method *method = findSetterOfMember(class, member);
 
   if (method && isPublic(method->flags))
-    return wsky_Class_callSetter(self, method, attribute, value);
+    return wsky_Class_callSetter(self, method, member->name, value);
 
-  return wsky_AttributeError_raiseNoAttr(class->name, attribute);
+  return wsky_AttributeError_raiseNoAttr(class->name, member->name);
 }
 
 ReturnValue wsky_Class_setPrivate(Class *class, Object *self,
-                                  const char *attribute,
+                                  const MemberName *member,
                                   Value value) {
   if (!wsky_Object_isA(self, class))
     return raiseTypeError(class->name, wsky_Object_getClass(self)->name);
 
-  Method *method = wsky_Class_findSetter(class, attribute);
+  Method *method = findSetterOfMember(class, member);
   if (method)
-    return wsky_Class_callSetter(self, method, attribute, value);
+    return wsky_Class_callSetter(self, method, member->name, value);
 
-  return wsky_Class_setField(class, self, attribute, value);
+  return setFieldValue(class, self, member, value);
 }
 
 
 
 Method *wsky_Class_findLocalMethod(Class *class, const char *name) {
-  return wsky_Dict_get(class->methods, name);
+  Method *method = wsky_Dict_get(class->methods, name);
+  if (!method && class->methodDefs)
+    method = createPendingMethod(class, name);
+  return method;
 }
 
-Method *wsky_Class_findMethodOrGetter(Class *class, const char *name) {
+/* Finds a method in the dictionaries of the class and its superclasses */
+static Method *findInHierarchy(Class *class, const char *name) {
   Method *method = wsky_Class_findLocalMethod(class, name);
   if (method)
     return method;
@@ -416,12 +797,41 @@ Method *wsky_Class_findMethodOrGetter(Class *class, const char *name) {
   return NULL;
 }
 
+Method *wsky_Class_findMethodOrGetter(Class *class, const char *name) {
+  if (!class->finalized)
+    return findInHierarchy(class, name);
+
+  int selector = wsky_selector_find(name);
+  if (selector < 0)
+    return NULL;
+  return wsky_Class_findMethodBySelector(class, (unsigned)selector);
+}
+
+Method *wsky_Class_findMethodBySelector(Class *class, unsigned selector) {
+  if (!class->finalized)
+    return findInHierarchy(class, wsky_selector_getName(selector));
+
+  Method **slot = findMethodSlot(class, selector);
+  if (!slot)
+    return NULL;
+  if (*slot == PENDING_METHOD)
+    *slot = findInHierarchy(class, wsky_selector_getName(selector));
+  return *slot;
+}
+
 
 Method *wsky_Class_findLocalSetter(Class *class, const char *name) {
   return wsky_Dict_get(class->setters, name);
 }
 
 Method *wsky_Class_findSetter(Class *class, const char *name) {
+  if (class->finalized) {
+    int selector = wsky_selector_find(name);
+    if (selector < 0)
+      return NULL;
+    return wsky_Class_findSetterBySelector(class, (unsigned)selector);
+  }
+
   Method *method = wsky_Class_findLocalSetter(class, name);
   if (method)
     return method;
@@ -431,6 +841,17 @@ Method *wsky_Class_findSetter(Class *class, const char *name) {
   return NULL;
 }
 
+Method *wsky_Class_findSetterBySelector(Class *class, unsigned selector) {
+  if (!class->finalized)
+    return wsky_Class_findSetter(class, wsky_selector_getName(selector));
+
+  if (!class->builtinTable)
+    return findEntry(&class->setterTable, selector)->method;
+  if (selector >= wsky_Selector_BUILTIN_COUNT)
+    return NULL;
+  return class->builtinTable->setters[selector];
+}
+
 
 ReturnValue wsky_Class_construct(Class *class,
                                  unsigned parameterCount,
@@ -49,7 +49,7 @@ Exception *wsky_Exception_new(const char *message,
   }
   if (r.exception)
     abort();
-  return (Exception *) r.v.v.objectValue;
+  return (Exception *) Value_getObject(r.v);
 }
 
 static ReturnValue construct(Object *object,
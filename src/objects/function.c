@@ -25,6 +25,24 @@ const ClassDef wsky_Function_CLASS_DEF = {
 Class *wsky_Function_CLASS;
 
 
+/** The call made by the wsky_Function_callSelf() which gets `exception` */
+static struct {
+  /** The exception returned by wsky_Function_tailCall() */
+  Exception *exception;
+
+  /** The function, or NULL if there is no pending tail call */
+  Function *function;
+
+  /** The class and the receiver of a method, or NULL */
+  Class *class;
+  Object *self;
+
+  unsigned parameterCount;
+
+  Value parameters[wsky_Function_MAX_TAIL_CALL_PARAMETERS];
+} tailCall;
+
+
 
 Function *wsky_Function_newFromWsky(const char *name,
                                     const FunctionNode *node,
@@ -32,10 +50,10 @@ Function *wsky_Function_newFromWsky(const char *name,
   ReturnValue r = wsky_Object_new(wsky_Function_CLASS, 0, NULL);
   if (r.exception)
     abort();
-  Function *function = (Function *) r.v.v.objectValue;
+  Function *function = (Function *) Value_getObject(r.v);
   function->name = name ? wsky_strdup(name) : NULL;
   assert(node);
-  function->node = (FunctionNode *)wsky_ASTNode_copy((const Node *)node);
+  function->node = wsky_FunctionNode_retain(node);
   function->globalScope = globalScope;
   return function;
 }
@@ -44,7 +62,7 @@ Function *wsky_Function_newFromC(const char *name, const MethodDef *def) {
   ReturnValue r = wsky_Object_new(wsky_Function_CLASS, 0, NULL);
   if (r.exception)
     abort();
-  Function *function = (Function *) r.v.v.objectValue;
+  Function *function = (Function *) Value_getObject(r.v);
   function->name = name ? wsky_strdup(name) : NULL;
   function->node = NULL;
   assert(def);
@@ -74,7 +92,13 @@ static void acceptGC(Object *object) {
 
 static void addVariable(Scope *scope, Node *node, const Value *value) {
   IdentifierNode *identifier = (IdentifierNode *) node;
-  wsky_Scope_addVariable(scope, identifier->name, *value);
+  if (wsky_LexicalAddress_isResolved(identifier->address)) {
+    int slot = identifier->address.slot;
+    scope->slots[slot] = *value;
+    scope->declared[slot] = true;
+  } else {
+    wsky_Scope_addVariable(scope, identifier->name, *value);
+  }
 }
 
 static void addVariables(Scope *scope,
@@ -100,6 +124,57 @@ static ReturnValue callNativeFunction(Function *function,
                              parameters);
 }
 
+bool wsky_Function_acceptsParameterCount(const Function *function,
+                                         unsigned parameterCount) {
+  return function->node->parameterCount == parameterCount;
+}
+
+Scope *wsky_Function_enterScope(Function *function,
+                                Class *class,
+                                Object *self,
+                                const Value *parameters) {
+  Scope *scope = wsky_Scope_enter(function->globalScope,
+                                  class, self,
+                                  function->node->layout);
+  wsky_eval_pushScope(scope);
+  addVariables(scope, function->node->parameters, parameters);
+  return scope;
+}
+
+void wsky_Function_leaveScope(Scope *scope) {
+  wsky_eval_popScope();
+  wsky_Scope_leave(scope);
+}
+
+/* Calls a function written in Whiskey */
+static ReturnValue callWskyFunction(Function *function,
+                                    Class *class,
+                                    Object *self,
+                                    unsigned parameterCount,
+                                    const Value *parameters) {
+  if (!wsky_Function_acceptsParameterCount(function, parameterCount))
+    RAISE_NEW_PARAMETER_ERROR("Invalid parameter count");
+
+  Scope *innerScope = wsky_Function_enterScope(function, class, self,
+                                               parameters);
+
+  ReturnValue rv = ReturnValue_NULL;
+  if (wsky_getEngine() != wsky_Engine_AST) {
+    rv = wsky_vm_runFunction(function->node, innerScope);
+  } else {
+    NodeList *child = function->node->children;
+    while (child) {
+      rv = wsky_evalNode(child->node, innerScope);
+      if (rv.exception)
+        break;
+      child = child->next;
+    }
+  }
+
+  wsky_Function_leaveScope(innerScope);
+  return rv;
+}
+
 ReturnValue wsky_Function_callSelf(Function *function,
                                    Class *class,
                                    Object *self,
@@ -112,24 +187,76 @@ ReturnValue wsky_Function_callSelf(Function *function,
     return callNativeFunction(function, class, self,
                               parameterCount, parameters);
 
-  NodeList *params = function->node->parameters;
-  unsigned wantedParamCount = wsky_ASTNodeList_getCount(params);
-  if (wantedParamCount != parameterCount)
-    RAISE_NEW_PARAMETER_ERROR("Invalid parameter count");
+  /* On the C stack, to be scanned by the garbage collector */
+  Value tailCallParameters[wsky_Function_MAX_TAIL_CALL_PARAMETERS];
 
-  Scope *innerScope = wsky_Scope_new(function->globalScope, class, self);
-  wsky_eval_pushScope(innerScope);
-  addVariables(innerScope, params, parameters);
+  for (;;) {
+    ReturnValue rv = callWskyFunction(function, class, self,
+                                      parameterCount, parameters);
+    if (rv.exception != tailCall.exception)
+      return rv;
 
-  ReturnValue rv = ReturnValue_NULL;
-  NodeList *child = function->node->children;
-  while (child) {
-    rv = wsky_evalNode(child->node, innerScope);
-    if (rv.exception)
-      break;
-    child = child->next;
+    /* The caller has returned, this frame is reused for the callee */
+    function = tailCall.function;
+    parameterCount = tailCall.parameterCount;
+    memcpy(tailCallParameters, tailCall.parameters,
+           sizeof(Value) * parameterCount);
+    parameters = tailCallParameters;
+    class = tailCall.class;
+    self = tailCall.self;
+    tailCall.function = NULL;
+    tailCall.class = NULL;
+    tailCall.self = NULL;
   }
+}
 
-  wsky_eval_popScope();
-  return rv;
+
+ReturnValue wsky_Function_tailCall(Function *function,
+                                   unsigned parameterCount,
+                                   const Value *parameters) {
+  return wsky_Function_tailCallSelf(function, NULL, NULL,
+                                    parameterCount, parameters);
+}
+
+ReturnValue wsky_Function_tailCallSelf(Function *function,
+                                       Class *class,
+                                       Object *self,
+                                       unsigned parameterCount,
+                                       const Value *parameters) {
+  assert(wsky_Function_canTailCall(function, parameterCount));
+  assert(!tailCall.function);
+  if (self)
+    assert(class);
+  tailCall.function = function;
+  tailCall.class = class;
+  tailCall.self = self;
+  tailCall.parameterCount = parameterCount;
+  memcpy(tailCall.parameters, parameters, sizeof(Value) * parameterCount);
+  RAISE_EXCEPTION(tailCall.exception);
+}
+
+void wsky_Function_initTailCall(void) {
+  tailCall.exception = wsky_Exception_new("Tail call outside of a function",
+                                          NULL);
+  tailCall.function = NULL;
+  tailCall.class = NULL;
+  tailCall.self = NULL;
+}
+
+void wsky_Function_freeTailCall(void) {
+  tailCall.exception = NULL;
+  tailCall.function = NULL;
+  tailCall.class = NULL;
+  tailCall.self = NULL;
+}
+
+void wsky_Function_visitTailCall(void) {
+  wsky_GC_visitObject(tailCall.exception);
+  if (!tailCall.function)
+    return;
+  wsky_GC_visitObject(tailCall.function);
+  wsky_GC_visitObject(tailCall.class);
+  wsky_GC_visitObject(tailCall.self);
+  for (unsigned i = 0; i < tailCall.parameterCount; i++)
+    wsky_GC_visitValue(tailCall.parameters[i]);
 }
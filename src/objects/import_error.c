@@ -32,7 +32,7 @@ ImportError *wsky_ImportError_new(const char *message) {
   r = wsky_Object_new(wsky_ImportError_CLASS, 1, &v);
   if (r.exception)
     abort();
-  return (ImportError *) r.v.v.objectValue;
+  return (ImportError *) Value_getObject(r.v);
 }
 
 
@@ -38,7 +38,7 @@ InstanceMethod *wsky_InstanceMethod_new(Method *method, Value self) {
   ReturnValue r = wsky_Object_new(wsky_InstanceMethod_CLASS, 0, NULL);
   if (r.exception)
     return NULL;
-  InstanceMethod *instanceMethod = (InstanceMethod *) r.v.v.objectValue;
+  InstanceMethod *instanceMethod = (InstanceMethod *) Value_getObject(r.v);
   instanceMethod->method = method;
   instanceMethod->self = self;
 
@@ -76,6 +76,6 @@ static ReturnValue toString(InstanceMethod *object) {
 }
 
 bool wsky_isInstanceMethod(const Value value) {
-  return value.type == Type_OBJECT &&
+  return Value_getType(value) == Type_OBJECT &&
     wsky_getClass(value) == wsky_InstanceMethod_CLASS;
 }
@@ -50,11 +50,12 @@ static Method *new(Class *class, const char *name, MethodFlags flags,
   ReturnValue r = wsky_Object_new(wsky_Method_CLASS, 0, NULL);
   if (r.exception)
     return NULL;
-  Method *self = (Method *) r.v.v.objectValue;
+  Method *self = (Method *) Value_getObject(r.v);
   self->defClass = class;
   self->name = wsky_strdup(name);
   self->flags = flags;
   self->function = function;
+  self->fieldIndex = -1;
   return self;
 }
 
@@ -87,15 +88,61 @@ Method *wsky_Method_newFromWskyDefault(const char *name,
 }
 
 
+/*
+ * An operator method called like any other method, like
+ * `String.get('a', 'operator *')(1.5)`, can return the shared
+ * NotImplementedError of the operators. Only the operator dispatch sees
+ * it, through wsky_Method_callOperator(); the other callers get the
+ * TypeError of the operator instead.
+ */
+static ReturnValue translateNotImplemented(ReturnValue rv,
+                                           const Method *method,
+                                           Value self,
+                                           unsigned parameterCount,
+                                           const Value *parameters) {
+  if (!rv.exception || rv.exception != ReturnValue_NOT_IMPLEMENTED.exception)
+    return rv;
+  if (parameterCount == 1)
+    return wsky_TypeError_raiseUnsupportedOperands(wsky_getClassName(self),
+                                                   method->name,
+                                                   parameters[0]);
+  RAISE_NEW_TYPE_ERROR("Unsupported operands");
+}
+
+ReturnValue wsky_Method_callOperator(Method *method,
+                                     Object *self,
+                                     Value right) {
+  assert(method->function);
+
+  return wsky_Function_callSelf(method->function,
+                                method->defClass, self,
+                                1, &right);
+}
+
 ReturnValue wsky_Method_call(Method *method,
                              Object *self,
                              unsigned parameterCount,
                              const Value *parameters) {
   assert(method->function);
 
-  return wsky_Function_callSelf(method->function,
-                                method->defClass, self,
-                                parameterCount, parameters);
+  ReturnValue rv = wsky_Function_callSelf(method->function,
+                                          method->defClass, self,
+                                          parameterCount, parameters);
+  return translateNotImplemented(rv, method, Value_fromObject(self),
+                                 parameterCount, parameters);
+}
+
+ReturnValue wsky_Method_tailCall(Method *method,
+                                 Object *self,
+                                 unsigned parameterCount,
+                                 const Value *parameters) {
+  assert(method->function);
+
+  if (!wsky_Function_canTailCall(method->function, parameterCount))
+    return wsky_Method_call(method, self, parameterCount, parameters);
+  return wsky_Function_tailCallSelf(method->function,
+                                    method->defClass, self,
+                                    parameterCount, parameters);
 }
 
 ReturnValue wsky_Method_call0(Method *method,
@@ -120,8 +167,11 @@ ReturnValue wsky_Method_callValue(Method *method,
   if (method->function->node)
     abort();
 
-  return wsky_MethodDef_callValue(&method->function->cMethod,
-                                  self, parameterCount, parameters);
+  ReturnValue rv = wsky_MethodDef_callValue(&method->function->cMethod,
+                                            self, parameterCount,
+                                            parameters);
+  return translateNotImplemented(rv, method, self,
+                                 parameterCount, parameters);
 }
 
 ReturnValue wsky_Method_callValue0(Method *method,
@@ -71,7 +71,7 @@ Module *wsky_Module_new(const char *name,
   ReturnValue r = wsky_Object_new(wsky_Module_CLASS, 0, NULL);
   if (r.exception)
     return NULL;
-  Module *module = (Module *)r.v.v.objectValue;
+  Module *module = (Module *)Value_getObject(r.v);
 
   module->name = wsky_strdup(name);
   wsky_Dict_init(&module->members);
@@ -166,6 +166,7 @@ ModuleList *wsky_Module_getModules(void) {
 
 void wsky_Module_deleteModules(void) {
   ModuleList_delete(modules);
+  modules = NULL;
 }
 
 
@@ -34,7 +34,7 @@ NameError *wsky_NameError_new(const char *message) {
   r = wsky_Object_new(wsky_NameError_CLASS, 1, &v);
   if (r.exception)
     abort();
-  return (NameError *) r.v.v.objectValue;
+  return (NameError *) Value_getObject(r.v);
 }
 
 
@@ -34,7 +34,17 @@ NotImplError *wsky_NotImplementedError_new(const char *message) {
   r = wsky_Object_new(wsky_NotImplementedError_CLASS, 1, &v);
   if (r.exception)
     abort();
-  return (NotImplError *) r.v.v.objectValue;
+  return (NotImplError *) Value_getObject(r.v);
+}
+
+
+void wsky_NotImplementedError_initSingleton(void) {
+  NotImplError *e = wsky_NotImplementedError_new("Not implemented");
+  ReturnValue_NOT_IMPLEMENTED = ReturnValue_fromException((Exception *)e);
+}
+
+void wsky_NotImplementedError_freeSingleton(void) {
+  ReturnValue_NOT_IMPLEMENTED = ReturnValue_fromException(NULL);
 }
 
 
@@ -4,70 +4,17 @@
 #include "../heaps.h"
 
 
-static void acceptGcOnField(const char* name, void *value_) {
-  (void) name;
-  wsky_GC_visitValue(*(Value *)value_);
-}
-
-void wsky_ObjectFields_acceptGc(ObjectFields *fields) {
-  wsky_Dict_apply(&fields->fields, &acceptGcOnField);
-  if (fields->parent)
-    wsky_ObjectFields_acceptGc(fields->parent);
-}
-
-static void freeField(const char *name, void *value) {
-  (void) name;
-  wsky_free(value);
-}
-
-void wsky_ObjectFields_free(ObjectFields *fields) {
-  wsky_Dict_apply(&fields->fields, &freeField);
-  wsky_Dict_free(&fields->fields);
-  if (fields->parent) {
-    wsky_ObjectFields_free(fields->parent);
-    wsky_free(fields->parent);
-  }
-}
-
-static void initFields(ObjectFields *fields, Class *class);
-
-static ObjectFields *newFields(Class *class) {
-  if (class->native)
+/* Returns the fields of a new object, or NULL if there is none */
+static ObjectField *newFields(const Class *class) {
+  unsigned count = wsky_Class_getFieldCount(class);
+  if (count == 0)
     return NULL;
-  ObjectFields *fields = wsky_safeMalloc(sizeof(ObjectFields));
-  initFields(fields, class);
+  ObjectField *fields = wsky_safeMalloc(count * sizeof(ObjectField));
+  for (unsigned i = 0; i < count; i++)
+    fields[i] = (ObjectField) {Value_NULL, false};
   return fields;
 }
 
-static void initFields(ObjectFields *fields, Class *class) {
-  if (class->native)
-    return;
-  wsky_Dict_init(&fields->fields);
-  fields->parent = newFields(class->super);
-}
-
-static void printField(const char* name, void *value_) {
-  Value *value = (Value *)value_;
-  ReturnValue rv = wsky_toString(*value);
-  printf("    %s = ", name);
-  if (rv.exception) {
-    puts("<toString has failed>");
-  } else {
-    String *s = (String *)rv.v.v.objectValue;
-    puts(s->string);
-  }
-}
-
-void wsky_ObjectFields_print(ObjectFields *fields,
-                             const Class *class) {
-  printf("\nfields (in %s):\n", class->name);
-  wsky_Dict_apply(&fields->fields, &printField);
-  if (fields->parent)
-    wsky_ObjectFields_print(fields->parent, class->super);
-  else
-    puts("end");
-}
-
 
 
 static ReturnValue toString(Value *self) {
@@ -85,9 +32,7 @@ static ReturnValue getClass(Value *self) {
   static ReturnValue operator##name(Value *self, Value *value) {        \
     (void) self;                                                        \
     (void) value;                                                       \
-    NotImplementedError *e;                                             \
-    e = wsky_NotImplementedError_new("Not implemented");                \
-    RAISE_EXCEPTION((Exception *) e);                                   \
+    RETURN_NOT_IMPLEMENTED;                                             \
   }
 
 #define ROP(name) OP(name) OP(R##name)
@@ -165,15 +110,17 @@ ReturnValue wsky_Object_new(Class *class,
 
   object->class = class;
 
-  if (!class->native)
-    initFields(&object->fields, class);
+  if (!class->native) {
+    object->fields = newFields(class);
+    object->dynamicFields = NULL;
+  }
 
   if (class->constructor) {
     ReturnValue rv;
     rv = wsky_Method_call(class->constructor, object, paramCount, params);
     if (rv.exception) {
       if (!class->native)
-        wsky_ObjectFields_free(&object->fields);
+        wsky_Object_freeFields(object);
       wsky_heaps_freeObject(object);
       return rv;
     }
@@ -184,23 +131,24 @@ ReturnValue wsky_Object_new(Class *class,
 }
 
 
-const char *wsky_Object_getClassName(const Object *o) {
-  return wsky_Object_getClass(o)->name;
+void wsky_Object_freeFields(Object *object) {
+  wsky_free(object->fields);
+  DynamicField *field = object->dynamicFields;
+  while (field) {
+    DynamicField *next = field->next;
+    wsky_free(field->name);
+    wsky_free(field);
+    field = next;
+  }
 }
 
-static bool wsky_Class_isSuperclassOf(const Class *super,
-                                      const Class *sub) {
-  if (!sub->super)
-    return false;
-  if (super == sub->super)
-    return true;
-  return wsky_Class_isSuperclassOf(super, sub->super);
+
+const char *wsky_Object_getClassName(const Object *o) {
+  return wsky_Object_getClass(o)->name;
 }
 
 bool wsky_Object_isA(const Object *object, const Class *class) {
-  if (class == object->class)
-    return true;
-  return wsky_Class_isSuperclassOf(class, object->class);
+  return wsky_Class_isSubclass(object->class, class);
 }
 
 
@@ -225,14 +173,16 @@ Method *wsky_Object_findMethodOrGetter(Object *object, const char *name) {
 
 ReturnValue wsky_Object_get(Object *object, const char *name) {
   Class *class = wsky_Object_getClass(object);
-  return wsky_Class_get(class, object, name);
+  MemberName member = wsky_MemberName_fromString(name);
+  return wsky_Class_get(class, object, &member);
 }
 
 
 
 ReturnValue wsky_Object_set(Object *object, const char *name, Value value) {
   Class *class = wsky_Object_getClass(object);
-  return wsky_Class_set(class, object, name, value);
+  MemberName member = wsky_MemberName_fromString(name);
+  return wsky_Class_set(class, object, &member, value);
 }
 
 
@@ -281,6 +231,29 @@ ReturnValue wsky_Object_callMethod(Object *object,
 
 
 
+ReturnValue wsky_Object_callBinaryOperator(Object *object,
+                                           Operator operator,
+                                           bool reversed,
+                                           Value right) {
+  Class *class = wsky_Object_getClass(object);
+  Method *method = wsky_Class_findBinaryOperator(class, operator, reversed);
+
+  if (!method || !(method->flags & wsky_MethodFlags_PUBLIC)) {
+    char *methodName = wsky_asprintf("operator %s%s",
+                                     reversed ? "r" : "",
+                                     wsky_Operator_toString(operator));
+    Exception *e = method ?
+      createPrivateMethodError(object, methodName) :
+      createNoMethodError(object, methodName);
+    wsky_free(methodName);
+    RAISE_EXCEPTION(e);
+  }
+
+  return wsky_Method_callOperator(method, object, right);
+}
+
+
+
 ReturnValue wsky_Object_callMethod0(Object *object,
                                     const char *methodName) {
   return wsky_Object_callMethod(object, methodName, 0, NULL);
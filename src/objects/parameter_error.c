@@ -32,7 +32,7 @@ ParameterError *wsky_ParameterError_new(const char *message) {
   r = wsky_Object_new(wsky_ParameterError_CLASS, 1, &v);
   if (r.exception)
     abort();
-  return (ParameterError *) r.v.v.objectValue;
+  return (ParameterError *) Value_getObject(r.v);
 }
 
 
@@ -66,7 +66,7 @@ ReturnValue wsky_ProgramFile_new(const char *cPath) {
 ProgramFile *wsky_ProgramFile_getUnknown(const char *content) {
   ReturnValue rv = wsky_Object_new(wsky_ProgramFile_CLASS, 0, NULL);
   assert(!rv.exception);
-  ProgramFile *file = (ProgramFile *)rv.v.v.objectValue;
+  ProgramFile *file = (ProgramFile *)Value_getObject(rv.v);
   file->content = content ? wsky_strdup(content) : NULL;
   return file;
 }
@@ -30,12 +30,141 @@ Class *wsky_Scope_CLASS;
 
 
 
-Scope *wsky_Scope_new(Scope *parent, Class *class, Object *self) {
+Scope *wsky_Scope_newWithLayout(Scope *parent, Class *class, Object *self,
+                                ScopeLayout *layout) {
   ReturnValue rv = wsky_Object_new(wsky_Scope_CLASS, 0, NULL);
   if (rv.exception)
     return NULL;
 
-  Scope *scope = (Scope *) rv.v.v.objectValue;
+  Scope *scope = (Scope *) Value_getObject(rv.v);
+
+  if (class)
+    assert(!class->native);
+  scope->defClass = class;
+  scope->parent = parent;
+  scope->self = self;
+  scope->module = NULL;
+  scope->frame = false;
+  wsky_Dict_init(&scope->variables);
+
+  scope->layout = wsky_ScopeLayout_retain(layout);
+  scope->slots = NULL;
+  scope->declared = NULL;
+  if (layout && layout->count) {
+    unsigned count = layout->count;
+    scope->slots = wsky_safeMalloc(count * (sizeof(Value) + sizeof(bool)));
+    scope->declared = (bool *)(scope->slots + count);
+    memset(scope->declared, 0, count * sizeof(bool));
+  }
+  return scope;
+}
+
+Scope *wsky_Scope_new(Scope *parent, Class *class, Object *self) {
+  return wsky_Scope_newWithLayout(parent, class, self, NULL);
+}
+
+
+
+
+/*
+ * The frame stack is a list of chunks. The frames are allocated
+ * contiguously in the chunks, in the order of the calls.
+ */
+
+#define FRAME_CHUNK_SIZE (64 * 1024)
+
+#define FRAME_ALIGNMENT 16
+
+typedef struct FrameChunk_s {
+  struct FrameChunk_s *previous;
+  struct FrameChunk_s *next;
+
+  /** The size of the data following the chunk header */
+  size_t size;
+
+  /** The number of bytes used by the frames */
+  size_t used;
+} FrameChunk;
+
+/** The chunk of the last frame */
+static FrameChunk *currentChunk = NULL;
+
+static inline char *FrameChunk_getData(FrameChunk *chunk) {
+  return (char *)(chunk + 1);
+}
+
+static FrameChunk *FrameChunk_new(size_t size, FrameChunk *previous) {
+  if (size < FRAME_CHUNK_SIZE)
+    size = FRAME_CHUNK_SIZE;
+  FrameChunk *chunk = wsky_safeMalloc(sizeof(FrameChunk) + size);
+  chunk->previous = previous;
+  chunk->next = NULL;
+  chunk->size = size;
+  chunk->used = 0;
+  if (previous)
+    previous->next = chunk;
+  return chunk;
+}
+
+/* Deletes a chunk and the empty ones which follow it */
+static void FrameChunk_deleteFrom(FrameChunk *chunk) {
+  if (chunk->previous)
+    chunk->previous->next = NULL;
+  while (chunk) {
+    FrameChunk *next = chunk->next;
+    assert(chunk->used == 0);
+    wsky_free(chunk);
+    chunk = next;
+  }
+}
+
+static void *allocateFrame(size_t size) {
+  if (!currentChunk)
+    currentChunk = FrameChunk_new(size, NULL);
+
+  if (currentChunk->used + size > currentChunk->size) {
+    FrameChunk *next = currentChunk->next;
+    if (next && next->size < size) {
+      FrameChunk_deleteFrom(next);
+      next = NULL;
+    }
+    currentChunk = next ? next : FrameChunk_new(size, currentChunk);
+    assert(currentChunk->used == 0);
+  }
+
+  void *frame = FrameChunk_getData(currentChunk) + currentChunk->used;
+  currentChunk->used += size;
+  return frame;
+}
+
+static void freeFrame(Scope *frame) {
+  char *data = FrameChunk_getData(currentChunk);
+  assert((char *)frame >= data);
+  assert((char *)frame < data + currentChunk->used);
+  currentChunk->used = (size_t)((char *)frame - data);
+  if (currentChunk->used == 0 && currentChunk->previous)
+    currentChunk = currentChunk->previous;
+}
+
+void wsky_Scope_freeFrameStack(void) {
+  if (!currentChunk)
+    return;
+  while (currentChunk->previous)
+    currentChunk = currentChunk->previous;
+  FrameChunk_deleteFrom(currentChunk);
+  currentChunk = NULL;
+}
+
+static Scope *newFrame(Scope *parent, Class *class, Object *self,
+                       ScopeLayout *layout) {
+  unsigned count = layout->count;
+  size_t size = sizeof(Scope) + count * (sizeof(Value) + sizeof(bool));
+  size = (size + FRAME_ALIGNMENT - 1) / FRAME_ALIGNMENT * FRAME_ALIGNMENT;
+
+  Scope *scope = allocateFrame(size);
+  scope->class = wsky_Scope_CLASS;
+  scope->_gcMark = false;
+  scope->_initialized = true;
 
   if (class)
     assert(!class->native);
@@ -43,22 +172,40 @@ Scope *wsky_Scope_new(Scope *parent, Class *class, Object *self) {
   scope->parent = parent;
   scope->self = self;
   scope->module = NULL;
+  scope->frame = true;
   wsky_Dict_init(&scope->variables);
+
+  /* The node of the scope owns the layout while the frame exists */
+  scope->layout = layout;
+  scope->slots = (Value *)(scope + 1);
+  scope->declared = (bool *)(scope->slots + count);
+  memset(scope->declared, 0, count * sizeof(bool));
   return scope;
 }
 
+Scope *wsky_Scope_enter(Scope *parent, Class *class, Object *self,
+                        ScopeLayout *layout) {
+  if (!layout || layout->captured)
+    return wsky_Scope_newWithLayout(parent, class, self, layout);
+  return newFrame(parent, class, self, layout);
+}
+
+static void freeVariable(const char *name, void *valuePointer);
 
-static void addClass(Scope *scope, Class *class) {
-  Value value = wsky_Value_fromObject((Object *)class);
-  wsky_Scope_addVariable(scope, class->name, value);
+void wsky_Scope_leave(Scope *scope) {
+  if (!scope->frame)
+    return;
+  wsky_Dict_apply(&scope->variables, &freeVariable);
+  wsky_Dict_free(&scope->variables);
+  freeFrame(scope);
 }
 
+
+
 Scope *wsky_Scope_newRoot(Module *module) {
   Scope *scope = wsky_Scope_new(NULL, NULL, NULL);
 
-  const wsky_ClassArray *classes = wsky_getBuiltinClasses();
-  for (size_t i = 0; i < classes->count; i++)
-    addClass(scope, classes->classes[i]);
+  /* The builtins are not copied, see wsky_getBuiltin() */
 
   assert(module);
   scope->module = module;
@@ -82,16 +229,17 @@ static void freeVariable(const char *name, void *valuePointer) {
 }
 
 static ReturnValue destroy(Object *object) {
-  Scope *scope = (Scope *) object;
-
-  wsky_Dict_apply(&scope->variables, &freeVariable);
-  wsky_Dict_free(&scope->variables);
+  wsky_Scope_delete((Scope *) object);
   RETURN_NULL;
 }
 
 void wsky_Scope_delete(wsky_Scope *scope) {
   wsky_Dict_apply(&scope->variables, &freeVariable);
   wsky_Dict_free(&scope->variables);
+  wsky_free(scope->slots);
+  wsky_ScopeLayout_release(scope->layout);
+  scope->slots = NULL;
+  scope->layout = NULL;
 }
 
 
@@ -102,11 +250,24 @@ static void visitVariable(const char *name, void *valuePointer) {
   wsky_GC_visitValue(value);
 }
 
+void wsky_Scope_visit(Scope *scope) {
+  if (scope && scope->frame)
+    acceptGC((Object *)scope);
+  else
+    wsky_GC_visitObject(scope);
+}
+
 static void acceptGC(wsky_Object *object) {
-  // Do not visit the parent scope here, since the whole scope
-  // stack is visited in eval.c
+  // The parent is visited too, because a function keeps only the
+  // scope where it is defined
   Scope *scope = (Scope *) object;
+  wsky_Scope_visit(scope->parent);
   wsky_Dict_apply(&scope->variables, &visitVariable);
+  unsigned slotCount = scope->layout ? scope->layout->count : 0;
+  for (unsigned i = 0; i < slotCount; i++) {
+    if (scope->declared[i])
+      wsky_GC_visitValue(scope->slots[i]);
+  }
   wsky_GC_visitObject(scope->module);
   wsky_GC_visitObject(scope->self);
   wsky_GC_visitObject(scope->defClass);
@@ -119,12 +280,17 @@ static void printVariable(const char *name, void *value_) {
   ReturnValue rv = wsky_toString(value);
   if (rv.exception)
     abort();
-  wsky_String *string = (wsky_String *) rv.v.v.objectValue;
+  wsky_String *string = (wsky_String *) Value_getObject(rv.v);
   printf("%s = %s\n", name, string->string);
 }
 
 
 void wsky_Scope_print(const Scope *scope) {
+  unsigned slotCount = scope->layout ? scope->layout->count : 0;
+  for (unsigned i = 0; i < slotCount; i++) {
+    if (scope->declared[i])
+      printVariable(scope->layout->names[i], scope->slots + i);
+  }
   wsky_Dict_applyConst(&scope->variables, &printVariable);
   if (scope->parent) {
     printf("parent:\n");
@@ -133,39 +299,78 @@ void wsky_Scope_print(const Scope *scope) {
 }
 
 
+/* Returns the variable if the scope contains it, without the parents */
+static Value *findLocalVariable(const Scope *scope, const char *name) {
+  if (scope->layout) {
+    int slot = wsky_ScopeLayout_find(scope->layout, name);
+    if (slot >= 0)
+      return scope->declared[slot] ? scope->slots + slot : NULL;
+  }
+  return (Value *) wsky_Dict_get((Dict *)&scope->variables, name);
+}
+
+/* Returns the variable, without looking for the builtins */
+static Value *findVariable(const Scope *scope, const char *name) {
+  while (scope) {
+    Value *valuePointer = findLocalVariable(scope, name);
+    if (valuePointer)
+      return valuePointer;
+    scope = scope->parent;
+  }
+  return NULL;
+}
+
+
 void wsky_Scope_addVariable(Scope *scope, const char *name, Value value) {
+  if (scope->layout) {
+    int slot = wsky_ScopeLayout_find(scope->layout, name);
+    if (slot >= 0) {
+      scope->declared[slot] = true;
+      scope->slots[slot] = value;
+      return;
+    }
+  }
+
   Value *valuePointer = wsky_safeMalloc(sizeof(Value));
   *valuePointer = value;
+  wsky_free(wsky_Dict_get(&scope->variables, name));
   wsky_Dict_set(&scope->variables, name, valuePointer);
 }
 
 
+void wsky_Scope_undeclareSlots(Scope *scope) {
+  if (scope->layout)
+    memset(scope->declared, 0, scope->layout->count * sizeof(bool));
+}
+
+
 bool wsky_Scope_setVariable(Scope *scope,
                             const char *name, Value value) {
-  Value *valuePointer = (Value*) wsky_Dict_get(&scope->variables, name);
+  Value *valuePointer = findVariable(scope, name);
   if (valuePointer) {
     *valuePointer = value;
     return false;
   }
-  if (!scope->parent)
+
+  if (!wsky_getBuiltin(name))
     return true;
-  return wsky_Scope_setVariable(scope->parent, name, value);
+
+  /* The builtins are shared, so the module gets its own variable */
+  wsky_Scope_addVariable(wsky_Scope_getRoot(scope), name, value);
+  return false;
 }
 
 
 bool wsky_Scope_containsVariable(const Scope *scope, const char *name) {
-  if (wsky_Dict_contains(&scope->variables, name)) {
-    return true;
-  }
-  if (!scope->parent)
-    return false;
-  return wsky_Scope_containsVariable(scope->parent, name);
+  return findVariable(scope, name) || wsky_getBuiltin(name);
 }
 
 
 bool wsky_Scope_containsVariableLocally(const Scope *scope,
                                         const char *name) {
-  return wsky_Dict_contains(&scope->variables, name);
+  if (findLocalVariable(scope, name))
+    return true;
+  return !scope->parent && wsky_getBuiltin(name);
 }
 
 
@@ -183,13 +388,13 @@ wsky_Module *wsky_Scope_getModule(Scope *scope) {
 
 
 Value wsky_Scope_getVariable(Scope *scope, const char *name) {
-  Value *valuePointer = (Value*) wsky_Dict_get(&scope->variables, name);
-  if (valuePointer)
-    return *valuePointer;
-  if (!scope->parent) {
+  const Value *valuePointer = findVariable(scope, name);
+  if (!valuePointer)
+    valuePointer = wsky_getBuiltin(name);
+  if (!valuePointer) {
     fprintf(stderr, "wsky_Scope_getVariable(): error\n");
     wsky_Scope_print(scope);
     abort();
   }
-  return wsky_Scope_getVariable(scope->parent, name);
+  return *valuePointer;
 }
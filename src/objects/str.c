@@ -3,7 +3,7 @@
 #include "../whiskey_private.h"
 
 
-#define CAST_TO_STRING(value) ((String *) (value).v.objectValue)
+#define CAST_TO_STRING(value) ((String *) Value_getObject(value))
 
 static ReturnValue construct(Object *object,
                              unsigned paramCount,
@@ -77,11 +77,26 @@ String *wsky_String_new(const char *cString) {
   ReturnValue r = wsky_Object_new(wsky_String_CLASS, 0, NULL);
   if (r.exception)
     return NULL;
-  String *string = (String *) r.v.v.objectValue;
+  String *string = (String *) Value_getObject(r.v);
   string->string = wsky_strdup(cString);
   return string;
 }
 
+/** The roots of the Strings returned by wsky_String_getCharacter() */
+static GCRoot characters[256];
+
+String *wsky_String_getCharacter(char character) {
+  assert(character);
+  GCRoot *root = characters + (unsigned char)character;
+  if (root->object)
+    return (String *)root->object;
+
+  char cString[2] = {character, '\0'};
+  String *string = wsky_String_new(cString);
+  wsky_GC_addRoot(root, (Object *)string);
+  return string;
+}
+
 static ReturnValue construct(Object *object,
                              unsigned paramCount,
                              const Value *params) {
@@ -216,7 +231,7 @@ static String *concat(const char *left, size_t leftLength,
                       const char *right, size_t rightLength) {
 
   ReturnValue r = wsky_Object_new(wsky_String_CLASS, 0, NULL);
-  String *string = (String *) r.v.v.objectValue;
+  String *string = (String *) Value_getObject(r.v);
   size_t newLength = leftLength + rightLength;
   string->string = wsky_malloc(newLength + 1);
   if (!string->string) {
@@ -228,11 +243,16 @@ static String *concat(const char *left, size_t leftLength,
   return string;
 }
 
+String *wsky_String_concat(const String *left, const String *right) {
+  return concat(left->string, strlen(left->string),
+                right->string, strlen(right->string));
+}
+
 static String *multiply(const char *source, size_t sourceLength,
                         unsigned count) {
 
   ReturnValue r = wsky_Object_new(wsky_String_CLASS, 0, NULL);
-  String *string = (String *) r.v.v.objectValue;
+  String *string = (String *) Value_getObject(r.v);
   size_t newLength = sourceLength * count;
   string->string = wsky_malloc(newLength + 1);
   if (!string->string) {
@@ -252,31 +272,26 @@ static inline ReturnValue toString(String *self) {
 
 
 
-#define RAISE_NOT_IMPL                          \
-  RAISE_NEW_NOT_IMPLEMENTED_ERROR("")
-
-
-
 static inline char *castToCString(Value v) {
   // TODO: If the given value is not a string, an exception need to be
   // thrown.
   // Rewrite this function.
   assert(wsky_isString(v));
-  String *s = (String *) v.v.objectValue;
+  String *s = (String *) Value_getObject(v);
   return wsky_strdup(s->string);
 }
 
 static ReturnValue operatorEquals(String *self, Value *value) {
   if (!wsky_isString(*value))
-    RAISE_NOT_IMPL;
-  String *other = (String *)value->v.objectValue;
+    RETURN_NOT_IMPLEMENTED;
+  String *other = (String *)Value_getObject(*value);
   RETURN_BOOL(strcmp(self->string, other->string) == 0);
 }
 
 static ReturnValue operatorNotEquals(String *self, Value *value) {
   if (!wsky_isString(*value))
-    RAISE_NOT_IMPL;
-  String *other = (String *)value->v.objectValue;
+    RETURN_NOT_IMPLEMENTED;
+  String *other = (String *)Value_getObject(*value);
   RETURN_BOOL(strcmp(self->string, other->string) != 0);
 }
 
@@ -307,10 +322,10 @@ static ReturnValue operatorRPlus(String *self, Value *value) {
 
 
 static ReturnValue operatorStar(String *self, Value *value) {
-  if (value->type != Type_INT) {
-    RAISE_NOT_IMPL;
+  if (Value_getType(*value) != Type_INT) {
+    RETURN_NOT_IMPLEMENTED;
   }
-  wsky_int count = value->v.intValue;
+  wsky_int count = Value_getInt(*value);
   if (count < 0) {
     ValueError *e = wsky_ValueError_new("The factor cannot be negative");
     RAISE_EXCEPTION((Exception *)e);
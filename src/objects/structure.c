@@ -1,3 +1,4 @@
+#include <string.h>
 #include "../whiskey_private.h"
 
 
@@ -42,32 +43,25 @@ static ReturnValue construct(Object *object,
   (void)parameterCount;
   (void)parameters;
   Structure *self = (Structure *)object;
-  wsky_Dict_init(&self->members);
+  self->shape = wsky_Shape_getEmpty();
+  self->values = self->inlineValues;
+  self->capacity = wsky_Structure_INLINE_COUNT;
   RETURN_NULL;
 }
 
 
-static void freeMember(const char *name, void *valuePointer) {
-  (void)name;
-  wsky_free(valuePointer);
-}
-
 static ReturnValue destroy(Object *object) {
   Structure *self = (Structure *)object;
-  wsky_Dict_apply(&self->members, freeMember);
-  wsky_Dict_free(&self->members);
+  if (self->values != self->inlineValues)
+    wsky_free(self->values);
   RETURN_NULL;
 }
 
 
-static void visitMember(const char *name, void *valuePointer) {
-  (void)name;
-  wsky_GC_visitValue(*(Value*)valuePointer);
-}
-
 static void acceptGC(Object *object) {
   Structure *self = (Structure *)object;
-  wsky_Dict_apply(&self->members, visitMember);
+  for (unsigned i = 0; i < self->shape->count; i++)
+    wsky_GC_visitValue(self->values[i]);
 }
 
 static ReturnValue toString(Structure *self) {
@@ -76,20 +70,68 @@ static ReturnValue toString(Structure *self) {
 }
 
 
+static void grow(Structure *self) {
+  unsigned capacity = self->capacity * 2;
+  Value *values = wsky_safeMalloc(capacity * sizeof(Value));
+  memcpy(values, self->values, self->capacity * sizeof(Value));
+  if (self->values != self->inlineValues)
+    wsky_free(self->values);
+  self->values = values;
+  self->capacity = capacity;
+}
+
 ReturnValue wsky_Structure_set(Structure *self,
                                const char *name,
                                Value value) {
-  Value *newValue = wsky_safeMalloc(sizeof(Value));
-  *newValue = value;
-  wsky_Dict_set(&self->members, name, newValue);
+  int slot = wsky_Shape_find(self->shape, name);
+  if (slot < 0) {
+    if (self->shape->count == self->capacity)
+      grow(self);
+    self->shape = wsky_Shape_addMember(self->shape, name);
+    slot = (int)self->shape->count - 1;
+  }
+  self->values[slot] = value;
+  RETURN_VALUE(value);
+}
+
+ReturnValue wsky_Structure_setCached(Structure *self,
+                                     const char *name,
+                                     Value value,
+                                     ShapeCache *cache) {
+  if (cache->shape != self->shape) {
+    int slot = wsky_Shape_find(self->shape, name);
+    cache->shape = self->shape;
+    if (slot >= 0) {
+      cache->slot = (unsigned)slot;
+      cache->transition = NULL;
+    } else {
+      cache->transition = wsky_Shape_addMember(self->shape, name);
+      cache->slot = cache->transition->count - 1;
+    }
+  }
+
+  if (cache->transition) {
+    if (self->shape->count == self->capacity)
+      grow(self);
+    self->shape = cache->transition;
+  }
+  self->values[cache->slot] = value;
   RETURN_VALUE(value);
 }
 
 ReturnValue wsky_Structure_get(Structure *self, const char *attribute) {
-  if (!wsky_Dict_contains(&self->members, attribute))
+  int slot = wsky_Shape_find(self->shape, attribute);
+  if (slot < 0)
     return wsky_AttributeError_raiseNoAttr(wsky_Structure_CLASS->name,
                                            attribute);
+  RETURN_VALUE(self->values[slot]);
+}
 
-  Value *value = (Value *)wsky_Dict_get(&self->members, attribute);
-  RETURN_VALUE(*value);
+ReturnValue wsky_Structure_getCached(Structure *self, const char *attribute,
+                                     ShapeCache *cache) {
+  int slot = wsky_Shape_findCached(self->shape, attribute, cache);
+  if (slot < 0)
+    return wsky_AttributeError_raiseNoAttr(wsky_Structure_CLASS->name,
+                                           attribute);
+  RETURN_VALUE(self->values[slot]);
 }
@@ -31,7 +31,7 @@ SyntaxErrorEx *wsky_SyntaxErrorEx_new(SyntaxError *syntaxError) {
   ReturnValue r = wsky_Object_new(wsky_SyntaxErrorEx_CLASS, 1, &v);
   if (r.exception)
     abort();
-  return (SyntaxErrorEx *) r.v.v.objectValue;
+  return (SyntaxErrorEx *) Value_getObject(r.v);
 }
 
 
@@ -32,7 +32,19 @@ TypeError *wsky_TypeError_new(const char *message) {
   r = wsky_Object_new(wsky_TypeError_CLASS, 1, &v);
   if (r.exception)
     abort();
-  return (TypeError *) r.v.v.objectValue;
+  return (TypeError *) Value_getObject(r.v);
+}
+
+ReturnValue wsky_TypeError_raiseUnsupportedOperands(const char *leftClass,
+                                                    const char *operator,
+                                                    Value right) {
+  char *message = wsky_asprintf("Unsupported classes for %s: %s and %s",
+                                operator,
+                                leftClass,
+                                wsky_getClassName(right));
+  Exception *e = (Exception *)wsky_TypeError_new(message);
+  wsky_free(message);
+  RAISE_EXCEPTION(e);
 }
 
 
@@ -32,7 +32,7 @@ ValueError *wsky_ValueError_new(const char *message) {
   r = wsky_Object_new(wsky_ValueError_CLASS, 1, &v);
   if (r.exception)
     abort();
-  return (ValueError *) r.v.v.objectValue;
+  return (ValueError *) Value_getObject(r.v);
 }
 
 
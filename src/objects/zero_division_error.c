@@ -34,7 +34,7 @@ ZeroDivisionError *wsky_ZeroDivisionError_new(void) {
   r = wsky_Object_new(wsky_ZeroDivisionError_CLASS, 1, &v);
   if (r.exception)
     abort();
-  return (ZeroDivisionError *) r.v.v.objectValue;
+  return (ZeroDivisionError *) Value_getObject(r.v);
 }
 
 
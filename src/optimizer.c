@@ -0,0 +1,272 @@
+#include <stdlib.h>
+#include <string.h>
+#include "whiskey_private.h"
+
+
+/** The longest string created by the folding of an operator */
+#define MAX_FOLDED_STRING_LENGTH 256
+
+
+/** -1 until the environment is read */
+static int enabled = -1;
+
+bool wsky_optimizer_isEnabled(void) {
+  if (enabled < 0)
+    enabled = !getenv("WSKY_NO_OPTIMIZER");
+  return enabled;
+}
+
+void wsky_optimizer_setEnabled(bool newEnabled) {
+  enabled = newEnabled;
+}
+
+
+
+static Node *optimizeNode(Node *node);
+
+static void optimize(Node **node) {
+  if (*node)
+    *node = optimizeNode(*node);
+}
+
+static void optimizeList(NodeList *list) {
+  for (; list; list = list->next)
+    optimize(&list->node);
+}
+
+/** Removes the first element of a list and returns its node */
+static Node *takeFirst(NodeList **list) {
+  NodeList *first = *list;
+  Node *node = first->node;
+  *list = first->next;
+  wsky_free(first);
+  return node;
+}
+
+
+
+static bool isLiteral(const Node *node) {
+  switch (node->type) {
+  case wsky_ASTNodeType_NULL:
+  case wsky_ASTNodeType_BOOL:
+  case wsky_ASTNodeType_INT:
+  case wsky_ASTNodeType_FLOAT:
+  case wsky_ASTNodeType_STRING:
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+static Value getLiteralValue(const LiteralNode *node) {
+  switch (node->type) {
+  case wsky_ASTNodeType_BOOL:
+    return Value_fromBool(node->v.boolValue);
+
+  case wsky_ASTNodeType_INT:
+    return Value_fromInt(node->v.intValue);
+
+  case wsky_ASTNodeType_FLOAT:
+    return Value_fromFloat(node->v.floatValue);
+
+  case wsky_ASTNodeType_STRING:
+    return Value_fromObject((Object *)wsky_String_new(node->v.stringValue));
+
+  default:
+    return Value_NULL;
+  }
+}
+
+static bool isFoldable(Value value) {
+  if (!wsky_isString(value))
+    return true;
+  const String *string = (const String *)Value_getObject(value);
+  return strlen(string->string) <= MAX_FOLDED_STRING_LENGTH;
+}
+
+static Node *foldOperator(OperatorNode *node) {
+  if (node->left)
+    optimize(&node->left);
+  optimize(&node->right);
+
+  if ((node->left && !isLiteral(node->left)) || !isLiteral(node->right))
+    return (Node *)node;
+
+  Value right = getLiteralValue((const LiteralNode *)node->right);
+  ReturnValue rv;
+  if (node->left) {
+    Value left = getLiteralValue((const LiteralNode *)node->left);
+    rv = wsky_eval_binaryOperator(node, left, right);
+  } else {
+    rv = wsky_doUnaryOperation(node->operator, right);
+  }
+  if (rv.exception || !isFoldable(rv.v))
+    return (Node *)node;
+
+  LiteralNode *literal = wsky_LiteralNode_newFromValue(node->position, rv.v);
+  if (!literal)
+    return (Node *)node;
+
+  wsky_ASTNode_delete((Node *)node);
+  return (Node *)literal;
+}
+
+
+/*
+ * Removes the branches whose test is `false`. A `true` test makes its
+ * branch the `else` of the node, and the next branches are removed.
+ */
+static Node *optimizeIf(IfNode *node) {
+  optimizeList(node->tests);
+  optimizeList(node->expressions);
+  optimize(&node->elseNode);
+
+  NodeList **tests = &node->tests;
+  NodeList **expressions = &node->expressions;
+  while (*tests) {
+    const Node *test = (*tests)->node;
+    if (test->type != wsky_ASTNodeType_BOOL) {
+      tests = &(*tests)->next;
+      expressions = &(*expressions)->next;
+      continue;
+    }
+
+    bool value = ((const LiteralNode *)test)->v.boolValue;
+    wsky_ASTNode_delete(takeFirst(tests));
+    Node *expression = takeFirst(expressions);
+    if (!value) {
+      wsky_ASTNode_delete(expression);
+      continue;
+    }
+
+    wsky_ASTNodeList_delete(*tests);
+    wsky_ASTNodeList_delete(*expressions);
+    *tests = NULL;
+    *expressions = NULL;
+    if (node->elseNode)
+      wsky_ASTNode_delete(node->elseNode);
+    node->elseNode = expression;
+  }
+
+  if (node->tests)
+    return (Node *)node;
+
+  Node *result = node->elseNode;
+  if (!result)
+    result = (Node *)wsky_LiteralNode_newFromValue(node->position,
+                                                   Value_NULL);
+  node->elseNode = NULL;
+  wsky_ASTNode_delete((Node *)node);
+  return result;
+}
+
+
+/** Removes a `while` loop whose test is `false` */
+static Node *optimizeWhile(WhileNode *node) {
+  optimize(&node->test);
+  optimize(&node->body);
+
+  const Node *test = node->test;
+  if (test->type != wsky_ASTNodeType_BOOL ||
+      ((const LiteralNode *)test)->v.boolValue)
+    return (Node *)node;
+
+  Node *result = (Node *)wsky_LiteralNode_newFromValue(node->position,
+                                                       Value_NULL);
+  wsky_ASTNode_delete((Node *)node);
+  return result;
+}
+
+
+/** Replaces the parentheses around a literal with the literal */
+static Node *optimizeSequence(SequenceNode *node) {
+  optimizeList(node->children);
+
+  NodeList *children = node->children;
+  if (node->program || !children || children->next ||
+      !isLiteral(children->node))
+    return (Node *)node;
+
+  Node *literal = takeFirst(&node->children);
+  wsky_ASTNode_delete((Node *)node);
+  return literal;
+}
+
+
+static Node *optimizeNode(Node *node) {
+  switch (node->type) {
+  case wsky_ASTNodeType_TPLT_PRINT:
+    optimize(&((TpltPrintNode *)node)->child);
+    break;
+
+  case wsky_ASTNodeType_VAR:
+    optimize(&((VarNode *)node)->right);
+    break;
+
+  case wsky_ASTNodeType_ASSIGNMENT:
+    optimize(&((AssignmentNode *)node)->right);
+    break;
+
+  case wsky_ASTNodeType_SEQUENCE:
+    return optimizeSequence((SequenceNode *)node);
+
+  case wsky_ASTNodeType_FUNCTION:
+    optimizeList(((FunctionNode *)node)->children);
+    break;
+
+  case wsky_ASTNodeType_CALL: {
+    CallNode *n = (CallNode *)node;
+    optimize(&n->left);
+    optimizeList(n->children);
+    break;
+  }
+
+  case wsky_ASTNodeType_UNARY_OPERATOR:
+  case wsky_ASTNodeType_BINARY_OPERATOR:
+    return foldOperator((OperatorNode *)node);
+
+  case wsky_ASTNodeType_MEMBER_ACCESS:
+    optimize(&((MemberAccessNode *)node)->left);
+    break;
+
+  case wsky_ASTNodeType_CLASS: {
+    ClassNode *n = (ClassNode *)node;
+    optimize(&n->superclass);
+    optimizeList(n->children);
+    break;
+  }
+
+  case wsky_ASTNodeType_CLASS_MEMBER:
+    optimize(&((ClassMemberNode *)node)->right);
+    break;
+
+  case wsky_ASTNodeType_EXPORT:
+    optimize(&((ExportNode *)node)->right);
+    break;
+
+  case wsky_ASTNodeType_IF:
+    return optimizeIf((IfNode *)node);
+
+  case wsky_ASTNodeType_WHILE:
+    return optimizeWhile((WhileNode *)node);
+
+  case wsky_ASTNodeType_FOR: {
+    ForNode *n = (ForNode *)node;
+    optimize(&n->iterable);
+    optimize(&n->body);
+    break;
+  }
+
+  default:
+    break;
+  }
+  return node;
+}
+
+
+Node *wsky_optimize(Node *node) {
+  if (!wsky_optimizer_isEnabled())
+    return node;
+  return optimizeNode(node);
+}
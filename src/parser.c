@@ -805,6 +805,76 @@ static ParserResult parseIf(TokenList **listPointer) {
 }
 
 
+/* Parses the colon and the body of a loop */
+static ParserResult parseLoopBody(TokenList **listPointer,
+                                  const Token *keywordToken) {
+  if (!tryToReadOperator(listPointer, OP(COLON)))
+    return createError("Expected colon", keywordToken->end);
+
+  if (!*listPointer)
+    return createError("Expected expression", keywordToken->end);
+
+  return parseExpr(listPointer);
+}
+
+
+static ParserResult parseWhile(TokenList **listPointer) {
+  Token *whileToken = tryToReadKeyword(listPointer, wsky_Keyword_WHILE);
+  if (!whileToken)
+    return ParserResult_NULL;
+
+  if (!*listPointer)
+    return createError("Expected condition", whileToken->end);
+
+  ParserResult pr = parseExpr(listPointer);
+  if (!pr.success)
+    return pr;
+  Node *test = pr.node;
+
+  pr = parseLoopBody(listPointer, whileToken);
+  if (!pr.success) {
+    wsky_ASTNode_delete(test);
+    return pr;
+  }
+
+  Node *node = (Node *)wsky_WhileNode_new(whileToken->begin, test, pr.node);
+  return createNodeResult(node);
+}
+
+
+static ParserResult parseFor(TokenList **listPointer) {
+  Token *forToken = tryToReadKeyword(listPointer, wsky_Keyword_FOR);
+  if (!forToken)
+    return ParserResult_NULL;
+
+  const char *name = parseIdentifierString(listPointer);
+  if (!name)
+    return createError("Expected variable name", forToken->end);
+
+  Token *inToken = tryToReadKeyword(listPointer, wsky_Keyword_IN);
+  if (!inToken)
+    return createError("Expected 'in'", forToken->end);
+
+  if (!*listPointer)
+    return createError("Expected expression", inToken->end);
+
+  ParserResult pr = parseExpr(listPointer);
+  if (!pr.success)
+    return pr;
+  Node *iterable = pr.node;
+
+  pr = parseLoopBody(listPointer, forToken);
+  if (!pr.success) {
+    wsky_ASTNode_delete(iterable);
+    return pr;
+  }
+
+  Node *node = (Node *)wsky_ForNode_new(forToken->begin, name,
+                                        iterable, pr.node);
+  return createNodeResult(node);
+}
+
+
 static ParserResult parseVar(TokenList **listPointer) {
   Token *varToken = tryToReadKeyword(listPointer, wsky_Keyword_VAR);
   if (!varToken)
@@ -934,6 +1004,14 @@ static ParserResult parseCoumpoundExpr(TokenList **listPointer) {
   if (!pr.success || pr.node)
     return pr;
 
+  pr = parseWhile(listPointer);
+  if (!pr.success || pr.node)
+    return pr;
+
+  pr = parseFor(listPointer);
+  if (!pr.success || pr.node)
+    return pr;
+
   pr = parseExport(listPointer);
   if (!pr.success || pr.node)
     return pr;
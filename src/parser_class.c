@@ -125,7 +125,7 @@ static ParserResult parseFlags(TokenList **listPointer,
 
 
 static unsigned getParameterCount(wsky_FunctionNode *function) {
-  return wsky_ASTNodeList_getCount(function->parameters);
+  return function->parameterCount;
 }
 
 
@@ -86,7 +86,17 @@ static int eval(const char *source, Scope *scope, bool debugMode) {
 
   assert(node->type == wsky_ASTNodeType_SEQUENCE);
 
-  ReturnValue rv = wsky_evalSequence((wsky_SequenceNode *)node, scope);
+  node = wsky_optimize(node);
+  wsky_SequenceNode *sequence = (wsky_SequenceNode *)node;
+  wsky_resolveSequence(sequence);
+  ReturnValue rv;
+  if (wsky_getEngine() != wsky_Engine_AST) {
+    wsky_Code *code = wsky_compileSequence(sequence);
+    rv = wsky_vm_run(code, scope);
+    wsky_Code_delete(code);
+  } else {
+    rv = wsky_evalSequence(sequence, scope);
+  }
   wsky_ASTNode_delete(node);
   if (rv.exception) {
     print_exception(rv.exception);
@@ -99,7 +109,7 @@ static int eval(const char *source, Scope *scope, bool debugMode) {
     return 3;
   }
 
-  wsky_String *string = (wsky_String *) rv.v.v.objectValue;
+  wsky_String *string = (wsky_String *) wsky_Value_getObject(rv.v);
   printf("%s\n", string->string);
   return 0;
 }
@@ -152,13 +162,13 @@ static char *wsky_readLine(const char *prompt) {
 
 
 // TODO: add history
-void wsky_repl(bool debugMode) {
+void wsky_repl(bool debugMode, wsky_Engine engine) {
 
   if (isChristmas()) {
     printf("Merry Christmas!\n");
   }
 
-  wsky_start();
+  wsky_startWithEngine(engine);
 
   Scope *scope = wsky_Scope_newRoot(wsky_Module_newMain());
   wsky_eval_pushScope(scope);
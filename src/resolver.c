@@ -0,0 +1,386 @@
+#include <assert.h>
+#include "whiskey_private.h"
+
+
+/**
+ * A scope known at compile time.
+ * The layout is NULL for a root scope.
+ */
+typedef struct StaticScope_s {
+  ScopeLayout *layout;
+  struct StaticScope_s *parent;
+
+  /** The fields of the class whose methods are resolved, or NULL */
+  ScopeLayout *fields;
+} StaticScope;
+
+
+static void resolveNode(Node *node, StaticScope *scope);
+
+static void resolveList(NodeList *list, StaticScope *scope) {
+  for (; list; list = list->next)
+    resolveNode(list->node, scope);
+}
+
+
+
+static void collectDeclarations(const Node *node, ScopeLayout *layout);
+
+static void collectListDeclarations(const NodeList *list,
+                                    ScopeLayout *layout) {
+  for (; list; list = list->next)
+    collectDeclarations(list->node, layout);
+}
+
+/*
+ * Adds the names declared by a node to the layout of its scope.
+ * The sequences, the functions and the loop bodies are not visited,
+ * since they create their own scopes.
+ */
+static void collectDeclarations(const Node *node, ScopeLayout *layout) {
+  if (!node)
+    return;
+
+  switch (node->type) {
+  case wsky_ASTNodeType_TPLT_PRINT:
+    collectDeclarations(((const TpltPrintNode *)node)->child, layout);
+    break;
+
+  case wsky_ASTNodeType_VAR: {
+    const VarNode *n = (const VarNode *)node;
+    collectDeclarations(n->right, layout);
+    wsky_ScopeLayout_add(layout, n->name);
+    break;
+  }
+
+  case wsky_ASTNodeType_ASSIGNMENT: {
+    const AssignmentNode *n = (const AssignmentNode *)node;
+    collectDeclarations(n->left, layout);
+    collectDeclarations(n->right, layout);
+    break;
+  }
+
+  case wsky_ASTNodeType_CALL: {
+    const CallNode *n = (const CallNode *)node;
+    collectDeclarations(n->left, layout);
+    collectListDeclarations(n->children, layout);
+    break;
+  }
+
+  case wsky_ASTNodeType_UNARY_OPERATOR:
+  case wsky_ASTNodeType_BINARY_OPERATOR: {
+    const OperatorNode *n = (const OperatorNode *)node;
+    collectDeclarations(n->left, layout);
+    collectDeclarations(n->right, layout);
+    break;
+  }
+
+  case wsky_ASTNodeType_MEMBER_ACCESS:
+    collectDeclarations(((const MemberAccessNode *)node)->left, layout);
+    break;
+
+  case wsky_ASTNodeType_CLASS: {
+    const ClassNode *n = (const ClassNode *)node;
+    collectDeclarations(n->superclass, layout);
+    wsky_ScopeLayout_add(layout, n->name);
+    break;
+  }
+
+  case wsky_ASTNodeType_IMPORT:
+    wsky_ScopeLayout_add(layout, ((const ImportNode *)node)->name);
+    break;
+
+  case wsky_ASTNodeType_EXPORT: {
+    const ExportNode *n = (const ExportNode *)node;
+    if (n->right) {
+      collectDeclarations(n->right, layout);
+      wsky_ScopeLayout_add(layout, n->name);
+    }
+    break;
+  }
+
+  case wsky_ASTNodeType_IF: {
+    const IfNode *n = (const IfNode *)node;
+    collectListDeclarations(n->tests, layout);
+    collectListDeclarations(n->expressions, layout);
+    collectDeclarations(n->elseNode, layout);
+    break;
+  }
+
+  case wsky_ASTNodeType_FOR:
+    collectDeclarations(((const ForNode *)node)->iterable, layout);
+    break;
+
+  default:
+    break;
+  }
+}
+
+
+
+static LexicalAddress findVariable(const StaticScope *scope,
+                                   const char *name) {
+  int depth = 0;
+  while (scope && scope->layout) {
+    int slot = wsky_ScopeLayout_find(scope->layout, name);
+    if (slot >= 0)
+      return (LexicalAddress) {depth, slot};
+    depth++;
+    scope = scope->parent;
+  }
+  return wsky_LexicalAddress_UNRESOLVED;
+}
+
+static LexicalAddress findLocalVariable(const StaticScope *scope,
+                                        const char *name) {
+  if (!scope->layout)
+    return wsky_LexicalAddress_UNRESOLVED;
+  int slot = wsky_ScopeLayout_find(scope->layout, name);
+  assert(slot >= 0);
+  return (LexicalAddress) {0, slot};
+}
+
+
+static void resolveSequence(SequenceNode *node, StaticScope *parent) {
+  wsky_ScopeLayout_release(node->layout);
+  node->layout = wsky_ScopeLayout_new();
+  collectListDeclarations(node->children, node->layout);
+
+  StaticScope scope = {node->layout, parent, parent->fields};
+  resolveList(node->children, &scope);
+}
+
+/*
+ * Resolves the body of a loop in the scope of the loop. The children
+ * of a sequence body are resolved as if they were in the loop scope.
+ */
+static void resolveLoopBody(LoopNode *node, StaticScope *scope) {
+  Node *body = node->body;
+  if (body->type == wsky_ASTNodeType_SEQUENCE) {
+    NodeList *children = ((SequenceNode *)body)->children;
+    collectListDeclarations(children, node->layout);
+    resolveList(children, scope);
+  } else {
+    collectDeclarations(body, node->layout);
+    resolveNode(body, scope);
+  }
+}
+
+/*
+ * The test is resolved before the declarations of the body are added to
+ * the layout, so that it does not see them.
+ */
+static void resolveWhile(WhileNode *node, StaticScope *parent) {
+  wsky_ScopeLayout_release(node->layout);
+  node->layout = wsky_ScopeLayout_new();
+
+  StaticScope scope = {node->layout, parent, parent->fields};
+  collectDeclarations(node->test, node->layout);
+  resolveNode(node->test, &scope);
+  resolveLoopBody((LoopNode *)node, &scope);
+}
+
+static void resolveFor(ForNode *node, StaticScope *parent) {
+  resolveNode(node->iterable, parent);
+
+  wsky_ScopeLayout_release(node->layout);
+  node->layout = wsky_ScopeLayout_new();
+  int slot = wsky_ScopeLayout_add(node->layout, node->name);
+  assert(slot == 0);
+  (void)slot;
+
+  StaticScope scope = {node->layout, parent, parent->fields};
+  resolveLoopBody((LoopNode *)node, &scope);
+}
+
+/*
+ * Marks the calls which are the value of the given node, when it is
+ * the last node of a function.
+ */
+static void markTailCalls(Node *node) {
+  switch (node->type) {
+  case wsky_ASTNodeType_CALL: {
+    CallNode *n = (CallNode *)node;
+    if (n->left->type != wsky_ASTNodeType_SUPER)
+      n->tailCall = true;
+    break;
+  }
+
+  case wsky_ASTNodeType_SEQUENCE: {
+    NodeList *children = ((SequenceNode *)node)->children;
+    if (children)
+      markTailCalls(wsky_ASTNodeList_getLastNode(children));
+    break;
+  }
+
+  case wsky_ASTNodeType_IF: {
+    IfNode *n = (IfNode *)node;
+    for (NodeList *expression = n->expressions; expression;
+         expression = expression->next)
+      markTailCalls(expression->node);
+    if (n->elseNode)
+      markTailCalls(n->elseNode);
+    break;
+  }
+
+  default:
+    break;
+  }
+}
+
+static void resolveFunction(FunctionNode *node, StaticScope *parent) {
+  wsky_ScopeLayout_release(node->layout);
+  node->layout = wsky_ScopeLayout_new();
+
+  StaticScope scope = {node->layout, parent, parent->fields};
+
+  for (NodeList *param = node->parameters; param; param = param->next) {
+    IdentifierNode *identifier = (IdentifierNode *)param->node;
+    assert(identifier->type == wsky_ASTNodeType_IDENTIFIER);
+    int slot = wsky_ScopeLayout_add(node->layout, identifier->name);
+    identifier->address = (LexicalAddress) {0, slot};
+  }
+
+  collectListDeclarations(node->children, node->layout);
+  resolveList(node->children, &scope);
+
+  if (node->children)
+    markTailCalls(wsky_ASTNodeList_getLastNode(node->children));
+}
+
+/*
+ * Collects the private fields of a class: its default getters and
+ * setters, and the members of `@` accessed by its methods.
+ */
+static void resolveClass(ClassNode *node, StaticScope *parent) {
+  resolveNode(node->superclass, parent);
+
+  wsky_ScopeLayout_release(node->fields);
+  node->fields = wsky_ScopeLayout_new();
+
+  for (NodeList *list = node->children; list; list = list->next) {
+    const ClassMemberNode *member = (const ClassMemberNode *)list->node;
+    if (!member->right)
+      wsky_ScopeLayout_add(node->fields, member->name);
+  }
+
+  StaticScope scope = *parent;
+  scope.fields = node->fields;
+  resolveList(node->children, &scope);
+}
+
+/*
+ * Marks the scopes which are captured by a function defined in the
+ * given scope: the scope itself and all its parents.
+ */
+static void markCaptured(StaticScope *scope) {
+  for (; scope && scope->layout; scope = scope->parent)
+    scope->layout->captured = true;
+}
+
+static void resolveNode(Node *node, StaticScope *scope) {
+  if (!node)
+    return;
+
+  switch (node->type) {
+  case wsky_ASTNodeType_TPLT_PRINT:
+    resolveNode(((TpltPrintNode *)node)->child, scope);
+    break;
+
+  case wsky_ASTNodeType_IDENTIFIER: {
+    IdentifierNode *n = (IdentifierNode *)node;
+    n->address = findVariable(scope, n->name);
+    break;
+  }
+
+  case wsky_ASTNodeType_VAR: {
+    VarNode *n = (VarNode *)node;
+    resolveNode(n->right, scope);
+    n->address = findLocalVariable(scope, n->name);
+    break;
+  }
+
+  case wsky_ASTNodeType_ASSIGNMENT: {
+    AssignmentNode *n = (AssignmentNode *)node;
+    resolveNode(n->left, scope);
+    resolveNode(n->right, scope);
+    break;
+  }
+
+  case wsky_ASTNodeType_SEQUENCE:
+    resolveSequence((SequenceNode *)node, scope);
+    break;
+
+  case wsky_ASTNodeType_FUNCTION:
+    markCaptured(scope);
+    resolveFunction((FunctionNode *)node, scope);
+    break;
+
+  case wsky_ASTNodeType_CALL: {
+    CallNode *n = (CallNode *)node;
+    resolveNode(n->left, scope);
+    resolveList(n->children, scope);
+    break;
+  }
+
+  case wsky_ASTNodeType_UNARY_OPERATOR:
+  case wsky_ASTNodeType_BINARY_OPERATOR: {
+    OperatorNode *n = (OperatorNode *)node;
+    resolveNode(n->left, scope);
+    resolveNode(n->right, scope);
+    break;
+  }
+
+  case wsky_ASTNodeType_MEMBER_ACCESS: {
+    MemberAccessNode *n = (MemberAccessNode *)node;
+    if (scope->fields && n->left->type == wsky_ASTNodeType_SELF)
+      n->fieldSlot = wsky_ScopeLayout_add(scope->fields, n->name);
+    n->selector = (int)wsky_selector_intern(n->name);
+    resolveNode(n->left, scope);
+    break;
+  }
+
+  case wsky_ASTNodeType_CLASS:
+    resolveClass((ClassNode *)node, scope);
+    break;
+
+  case wsky_ASTNodeType_CLASS_MEMBER:
+    resolveNode(((ClassMemberNode *)node)->right, scope);
+    break;
+
+  case wsky_ASTNodeType_EXPORT:
+    resolveNode(((ExportNode *)node)->right, scope);
+    break;
+
+  case wsky_ASTNodeType_IF: {
+    IfNode *n = (IfNode *)node;
+    resolveList(n->tests, scope);
+    resolveList(n->expressions, scope);
+    resolveNode(n->elseNode, scope);
+    break;
+  }
+
+  case wsky_ASTNodeType_WHILE:
+    resolveWhile((WhileNode *)node, scope);
+    break;
+
+  case wsky_ASTNodeType_FOR:
+    resolveFor((ForNode *)node, scope);
+    break;
+
+  default:
+    break;
+  }
+}
+
+
+
+void wsky_resolve(Node *node) {
+  StaticScope root = {NULL, NULL, NULL};
+  resolveNode(node, &root);
+}
+
+void wsky_resolveSequence(SequenceNode *node) {
+  StaticScope root = {NULL, NULL, NULL};
+  resolveList(node->children, &root);
+}
@@ -2,42 +2,27 @@
 
 
 const ReturnValue ReturnValue_TRUE = {
-  .v = {
-    .type = Type_BOOL,
-    .v = {
-      .boolValue = true
-    }
-  },
+  .v = wsky_Value_INIT_BOOL(true),
   .exception = NULL
 };
 
 const ReturnValue ReturnValue_FALSE = {
-  .v = {
-    .type = Type_BOOL,
-    .v = {
-      .boolValue = false
-    }
-  },
+  .v = wsky_Value_INIT_BOOL(false),
   .exception = NULL
 };
 
 const ReturnValue ReturnValue_NULL = {
-  .v = {
-    .type = Type_OBJECT,
-    .v = {
-      .objectValue = NULL
-    }
-  },
+  .v = wsky_Value_INIT_NULL,
   .exception = NULL
 };
 
 const ReturnValue ReturnValue_ZERO = {
-  .v = {
-    .type = Type_INT,
-    .v = {
-      .intValue = 0
-    }
-  },
+  .v = wsky_Value_INIT_INT(0),
+  .exception = NULL
+};
+
+ReturnValue ReturnValue_NOT_IMPLEMENTED = {
+  .v = wsky_Value_INIT_NULL,
   .exception = NULL
 };
 
@@ -9,6 +9,7 @@ typedef wsky_ReturnValue ReturnValue;
 # define ReturnValue_FALSE      wsky_ReturnValue_FALSE
 # define ReturnValue_NULL       wsky_ReturnValue_NULL
 # define ReturnValue_ZERO       wsky_ReturnValue_ZERO
+# define ReturnValue_NOT_IMPLEMENTED wsky_ReturnValue_NOT_IMPLEMENTED
 
 # define ReturnValue_fromBool           wsky_ReturnValue_fromBool
 # define ReturnValue_fromInt            wsky_ReturnValue_fromInt
@@ -26,6 +27,7 @@ typedef wsky_ReturnValue ReturnValue;
 # define RETURN_VALUE           wsky_RETURN_VALUE
 # define RETURN_OBJECT          wsky_RETURN_OBJECT
 # define RETURN_C_STRING        wsky_RETURN_C_STRING
+# define RETURN_NOT_IMPLEMENTED wsky_RETURN_NOT_IMPLEMENTED
 
 # define RAISE_EXCEPTION                wsky_RAISE_EXCEPTION
 # define RAISE_NEW_EXCEPTION            wsky_RAISE_NEW_EXCEPTION
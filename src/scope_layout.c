@@ -0,0 +1,57 @@
+#include <assert.h>
+#include <string.h>
+#include "whiskey_private.h"
+
+
+ScopeLayout *wsky_ScopeLayout_new(void) {
+  ScopeLayout *layout = wsky_safeMalloc(sizeof(ScopeLayout));
+  layout->referenceCount = 1;
+  layout->count = 0;
+  layout->capacity = 0;
+  layout->names = NULL;
+  layout->captured = false;
+  return layout;
+}
+
+ScopeLayout *wsky_ScopeLayout_retain(ScopeLayout *layout) {
+  if (layout)
+    layout->referenceCount++;
+  return layout;
+}
+
+void wsky_ScopeLayout_release(ScopeLayout *layout) {
+  if (!layout)
+    return;
+  assert(layout->referenceCount > 0);
+  if (--layout->referenceCount > 0)
+    return;
+
+  for (unsigned i = 0; i < layout->count; i++)
+    wsky_free(layout->names[i]);
+  wsky_free(layout->names);
+  wsky_free(layout);
+}
+
+int wsky_ScopeLayout_add(ScopeLayout *layout, const char *name) {
+  int slot = wsky_ScopeLayout_find(layout, name);
+  if (slot >= 0)
+    return slot;
+
+  if (layout->count == layout->capacity) {
+    layout->capacity = layout->capacity ? layout->capacity * 2 : 4;
+    layout->names = wsky_realloc(layout->names,
+                                 layout->capacity * sizeof(char *));
+    if (!layout->names)
+      abort();
+  }
+  layout->names[layout->count] = wsky_strdup(name);
+  return (int)layout->count++;
+}
+
+int wsky_ScopeLayout_find(const ScopeLayout *layout, const char *name) {
+  for (unsigned i = 0; i < layout->count; i++) {
+    if (strcmp(layout->names[i], name) == 0)
+      return (int)i;
+  }
+  return -1;
+}
@@ -0,0 +1,120 @@
+#include <string.h>
+#include "whiskey_private.h"
+
+
+/** The initial size of the hash table, a power of two */
+#define INITIAL_TABLE_SIZE 512
+
+static struct {
+  /** The interned names, indexed by selector */
+  char **names;
+
+  unsigned count;
+
+  /** The allocated length of `names` */
+  unsigned capacity;
+
+  /**
+   * An open addressing hash table of the selectors, -1 for an empty
+   * entry. It is at most half full.
+   */
+  int *table;
+
+  /** A power of two */
+  unsigned tableSize;
+
+  /** The number of calls to wsky_selector_find() */
+  unsigned long findCount;
+} selectors = {NULL, 0, 0, NULL, 0, 0};
+
+
+/* Returns the entry of the table which holds the name, or an empty one */
+static int *getEntry(const char *name) {
+  unsigned mask = selectors.tableSize - 1;
+  unsigned i = wsky_hashString(name) & mask;
+  while (selectors.table[i] >= 0 &&
+         strcmp(selectors.names[selectors.table[i]], name) != 0)
+    i = (i + 1) & mask;
+  return selectors.table + i;
+}
+
+static void resizeTable(unsigned size) {
+  wsky_free(selectors.table);
+  selectors.table = wsky_safeMalloc(size * sizeof(int));
+  selectors.tableSize = size;
+  for (unsigned i = 0; i < size; i++)
+    selectors.table[i] = -1;
+  for (unsigned selector = 0; selector < selectors.count; selector++)
+    *getEntry(selectors.names[selector]) = (int)selector;
+}
+
+static const char *const BUILTIN_NAMES[] = {
+#define X(id, name) name,
+  wsky_BUILTIN_SELECTORS(X)
+#undef X
+};
+
+/* Creates the table, with the builtin selectors */
+static void init(void) {
+  resizeTable(INITIAL_TABLE_SIZE);
+  for (unsigned i = 0; i < wsky_Selector_BUILTIN_COUNT; i++) {
+    if (wsky_selector_intern(BUILTIN_NAMES[i]) != i)
+      abort();
+  }
+}
+
+unsigned wsky_selector_intern(const char *name) {
+  if (!selectors.table)
+    init();
+
+  int *entry = getEntry(name);
+  if (*entry >= 0)
+    return (unsigned)*entry;
+
+  if (selectors.count == selectors.capacity) {
+    selectors.capacity = selectors.capacity ? selectors.capacity * 2 : 64;
+    selectors.names = wsky_realloc(selectors.names,
+                                   selectors.capacity * sizeof(char *));
+    if (!selectors.names)
+      abort();
+  }
+
+  unsigned selector = selectors.count++;
+  selectors.names[selector] = wsky_strdup(name);
+  *entry = (int)selector;
+
+  if (2 * selectors.count > selectors.tableSize)
+    resizeTable(2 * selectors.tableSize);
+  return selector;
+}
+
+int wsky_selector_find(const char *name) {
+  selectors.findCount++;
+  if (!selectors.table)
+    init();
+  return *getEntry(name);
+}
+
+const char *wsky_selector_getName(unsigned selector) {
+  return selectors.names[selector];
+}
+
+unsigned wsky_selector_getCount(void) {
+  return selectors.count;
+}
+
+unsigned long wsky_selector_getFindCount(void) {
+  return selectors.findCount;
+}
+
+void wsky_selector_free(void) {
+  for (unsigned i = 0; i < selectors.count; i++)
+    wsky_free(selectors.names[i]);
+  wsky_free(selectors.names);
+  wsky_free(selectors.table);
+  selectors.names = NULL;
+  selectors.count = 0;
+  selectors.capacity = 0;
+  selectors.table = NULL;
+  selectors.tableSize = 0;
+}
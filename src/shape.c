@@ -0,0 +1,73 @@
+#include <string.h>
+#include "whiskey_private.h"
+
+
+/** The root of the tree, or NULL before the first structure */
+static Shape *emptyShape = NULL;
+
+
+static Shape *newShape(Shape *parent, const char *name) {
+  Shape *shape = wsky_safeMalloc(sizeof(Shape));
+  shape->parent = parent;
+  shape->name = name ? wsky_strdup(name) : NULL;
+  shape->count = parent ? parent->count + 1 : 0;
+  shape->transitions = NULL;
+  shape->next = NULL;
+  return shape;
+}
+
+Shape *wsky_Shape_getEmpty(void) {
+  if (!emptyShape)
+    emptyShape = newShape(NULL, NULL);
+  return emptyShape;
+}
+
+Shape *wsky_Shape_addMember(Shape *shape, const char *name) {
+  for (Shape *child = shape->transitions; child; child = child->next)
+    if (strcmp(child->name, name) == 0)
+      return child;
+
+  Shape *child = newShape(shape, name);
+  child->next = shape->transitions;
+  shape->transitions = child;
+  return child;
+}
+
+int wsky_Shape_find(const Shape *shape, const char *name) {
+  for (; shape->parent; shape = shape->parent)
+    if (strcmp(shape->name, name) == 0)
+      return (int)shape->count - 1;
+  return -1;
+}
+
+int wsky_Shape_findCached(const Shape *shape, const char *name,
+                          ShapeCache *cache) {
+  if (cache->shape == shape)
+    return (int)cache->slot;
+
+  int slot = wsky_Shape_find(shape, name);
+  if (slot >= 0) {
+    cache->shape = shape;
+    cache->slot = (unsigned)slot;
+    cache->transition = NULL;
+  }
+  return slot;
+}
+
+
+static void deleteShape(Shape *shape) {
+  Shape *child = shape->transitions;
+  while (child) {
+    Shape *next = child->next;
+    deleteShape(child);
+    child = next;
+  }
+  wsky_free(shape->name);
+  wsky_free(shape);
+}
+
+void wsky_Shape_freeAll(void) {
+  if (emptyShape)
+    deleteShape(emptyShape);
+  emptyShape = NULL;
+}
@@ -0,0 +1,106 @@
+#include <assert.h>
+#include "whiskey_private.h"
+
+
+/*
+ * The values are allocated contiguously in a list of chunks, like the
+ * frames of the scopes. A chunk is kept when it becomes empty, so that
+ * the next calls don't allocate it again.
+ */
+
+/** The minimum number of values of a chunk */
+#define CHUNK_SIZE (8 * 1024)
+
+typedef struct Chunk_s {
+  struct Chunk_s *previous;
+  struct Chunk_s *next;
+
+  /** The number of values following the chunk header */
+  size_t size;
+
+  /** The number of allocated values */
+  size_t used;
+} Chunk;
+
+/** The chunk of the last allocated values */
+static Chunk *currentChunk = NULL;
+
+static inline Value *Chunk_getValues(Chunk *chunk) {
+  return (Value *)(chunk + 1);
+}
+
+static Chunk *Chunk_new(size_t size, Chunk *previous) {
+  if (size < CHUNK_SIZE)
+    size = CHUNK_SIZE;
+  Chunk *chunk = wsky_safeMalloc(sizeof(Chunk) + size * sizeof(Value));
+  chunk->previous = previous;
+  chunk->next = NULL;
+  chunk->size = size;
+  chunk->used = 0;
+  if (previous)
+    previous->next = chunk;
+  return chunk;
+}
+
+/* Deletes a chunk and the empty ones which follow it */
+static void Chunk_deleteFrom(Chunk *chunk) {
+  if (chunk->previous)
+    chunk->previous->next = NULL;
+  while (chunk) {
+    Chunk *next = chunk->next;
+    assert(chunk->used == 0);
+    wsky_free(chunk);
+    chunk = next;
+  }
+}
+
+/*
+ * The values are initialized, because the garbage collector visits the
+ * whole allocated values.
+ */
+Value *wsky_stack_allocate(size_t count) {
+  if (!currentChunk)
+    currentChunk = Chunk_new(count, NULL);
+
+  if (currentChunk->used + count > currentChunk->size) {
+    Chunk *next = currentChunk->next;
+    if (next && next->size < count) {
+      Chunk_deleteFrom(next);
+      next = NULL;
+    }
+    currentChunk = next ? next : Chunk_new(count, currentChunk);
+    assert(currentChunk->used == 0);
+  }
+
+  Value *values = Chunk_getValues(currentChunk) + currentChunk->used;
+  currentChunk->used += count;
+  for (size_t i = 0; i < count; i++)
+    values[i] = Value_NULL;
+  return values;
+}
+
+void wsky_stack_release(Value *values) {
+  Value *chunkValues = Chunk_getValues(currentChunk);
+  assert(values >= chunkValues);
+  assert(values <= chunkValues + currentChunk->used);
+  currentChunk->used = (size_t)(values - chunkValues);
+  if (currentChunk->used == 0 && currentChunk->previous)
+    currentChunk = currentChunk->previous;
+}
+
+void wsky_stack_visit(void) {
+  for (Chunk *chunk = currentChunk; chunk; chunk = chunk->previous) {
+    Value *values = Chunk_getValues(chunk);
+    for (size_t i = 0; i < chunk->used; i++)
+      wsky_GC_visitValue(values[i]);
+  }
+}
+
+void wsky_stack_free(void) {
+  if (!currentChunk)
+    return;
+  while (currentChunk->previous)
+    currentChunk = currentChunk->previous;
+  Chunk_deleteFrom(currentChunk);
+  currentChunk = NULL;
+}
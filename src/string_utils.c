@@ -67,3 +67,13 @@ char *wsky_strndup(const char *string, size_t maximum) {
   newString[length] = '\0';
   return newString;
 }
+
+
+uint32_t wsky_hashString(const char *string) {
+  uint32_t hash = 2166136261u;
+  while (*string) {
+    hash ^= (unsigned char)*string++;
+    hash *= 16777619u;
+  }
+  return hash;
+}
@@ -27,13 +27,13 @@ inline static char *floatToCString(wsky_float v) {
 
 /* Returns a malloc'd null-terminated string */
 static char *primitiveToCString(const Value value) {
-  switch (value.type) {
+  switch (Value_getType(value)) {
   case Type_BOOL:
-    return boolToCString(value.v.objectValue);
+    return boolToCString(Value_getBool(value));
   case Type_INT:
-    return intToCString(value.v.intValue);
+    return intToCString(Value_getInt(value));
   case Type_FLOAT:
-    return floatToCString(value.v.floatValue);
+    return floatToCString(Value_getFloat(value));
   case Type_OBJECT:
     abort();
   }
@@ -48,8 +48,8 @@ static String *primitiveToString(const Value value) {
 }
 
 ReturnValue wsky_toString(const Value value) {
-  if (value.type == Type_OBJECT) {
-    return wsky_Object_toString(value.v.objectValue);
+  if (Value_getType(value) == Type_OBJECT) {
+    return wsky_Object_toString(Value_getObject(value));
   }
   RETURN_OBJECT((Object *) primitiveToString(value));
 }
@@ -3,26 +3,11 @@
 #include "whiskey_private.h"
 
 
-const Value Value_NULL = {
-  .type = Type_OBJECT,
-  .v = {
-    .objectValue = NULL
-  }
-};
+const Value Value_NULL = wsky_Value_INIT_NULL;
 
-const Value Value_TRUE = {
-  .type = Type_BOOL,
-  .v = {
-    .boolValue = true
-  }
-};
+const Value Value_TRUE = wsky_Value_INIT_BOOL(true);
 
-const Value Value_FALSE = {
-  .type = Type_BOOL,
-  .v = {
-    .boolValue = false
-  }
-};
+const Value Value_FALSE = wsky_Value_INIT_BOOL(false);
 
 
 
@@ -37,7 +22,7 @@ Value *wsky_Value_new(Value v) {
 
 
 wsky_Class *wsky_getClass(const Value value) {
-  switch (value.type) {
+  switch (Value_getType(value)) {
   case Type_INT:
     return wsky_Integer_CLASS;
 
@@ -48,9 +33,9 @@ wsky_Class *wsky_getClass(const Value value) {
     return wsky_Float_CLASS;
 
   case Type_OBJECT:
-    if (!value.v.objectValue)
+    if (!Value_getObject(value))
       return wsky_Null_CLASS;
-    return value.v.objectValue->class;
+    return Value_getObject(value)->class;
   }
   abort();
 }
@@ -127,21 +112,21 @@ static int wsky_vaParseObject(wsky_Object *o,
 static int wsky_vaParseValue(Value value, const char format, va_list params) {
   switch (format) {
   case 'i':
-    if (value.type != Type_INT)
+    if (Value_getType(value) != Type_INT)
       return 1;
-    *va_arg(params, wsky_int *) = value.v.intValue;
+    *va_arg(params, wsky_int *) = Value_getInt(value);
     break;
 
   case 'f':
-    if (value.type != Type_FLOAT)
+    if (Value_getType(value) != Type_FLOAT)
       return 1;
-    *va_arg(params, double *) = (double) value.v.floatValue;
+    *va_arg(params, double *) = (double) Value_getFloat(value);
     break;
 
   default:
-    if (value.type != Type_OBJECT)
+    if (Value_getType(value) != Type_OBJECT)
       return 1;
-    return wsky_vaParseObject(value.v.objectValue, format, params);
+    return wsky_vaParseObject(Value_getObject(value), format, params);
   }
 
   return 0;
@@ -32,4 +32,10 @@ typedef wsky_Value Value;
 
 #define Value_new               wsky_Value_new
 
+#define Value_getType           wsky_Value_getType
+#define Value_getBool           wsky_Value_getBool
+#define Value_getInt            wsky_Value_getInt
+#define Value_getFloat          wsky_Value_getFloat
+#define Value_getObject         wsky_Value_getObject
+
 #endif /* VALUE_PRIVATE_H */
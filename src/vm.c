@@ -0,0 +1,607 @@
+#include <assert.h>
+#include <string.h>
+#include "vm_private.h"
+
+
+#define PUSH(value) (*s->sp++ = (value))
+#define POP() (*--s->sp)
+#define TOP() (s->sp[-1])
+
+/** The node of the given index */
+#define NODE(type, index) ((const type *)s->code->nodes[index])
+
+/** The name of the member access node of the given index */
+#define MEMBER_NODE(index) NODE(MemberAccessNode, index)
+
+/** Stores a return value in `rv` and stops on exception */
+#define CHECK(returnValue)                      \
+  do {                                          \
+    s->rv = (returnValue);                      \
+    if (s->rv.exception)                        \
+      return VMStatus_ERROR;                    \
+  } while (0)
+
+
+static Scope *enterScope(Scope *scope, const SequenceNode *node) {
+  Scope *inner = wsky_Scope_enter(scope,
+                                  scope->defClass,
+                                  scope->self,
+                                  node->layout);
+  wsky_eval_pushScope(inner);
+  return inner;
+}
+
+static Scope *leaveScope(Scope *scope) {
+  Scope *parent = scope->parent;
+  wsky_eval_popScope();
+  wsky_Scope_leave(scope);
+  return parent;
+}
+
+
+
+static inline VMStatus pushNull(VMState *s, int operand) {
+  (void)operand;
+  PUSH(Value_NULL);
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus pushTrue(VMState *s, int operand) {
+  (void)operand;
+  PUSH(Value_TRUE);
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus pushFalse(VMState *s, int operand) {
+  (void)operand;
+  PUSH(Value_FALSE);
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus pushConstant(VMState *s, int operand) {
+  PUSH(s->code->constants[operand]);
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus pushString(VMState *s, int operand) {
+  String *string = wsky_LiteralNode_getString(NODE(LiteralNode, operand));
+  PUSH(Value_fromObject((Object *)string));
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus loadVariable(VMState *s, int operand) {
+  const IdentifierNode *node = NODE(IdentifierNode, operand);
+  if (wsky_LexicalAddress_isResolved(node->address)) {
+    Value *variable = wsky_Scope_getSlot(s->scope, node->address);
+    if (variable) {
+      PUSH(*variable);
+      return VMStatus_CONTINUE;
+    }
+  }
+  CHECK(wsky_eval_getVariable(node, s->scope));
+  PUSH(s->rv.v);
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus declareVariable(VMState *s, int operand) {
+  CHECK(wsky_eval_declareVariable(NODE(VarNode, operand), TOP(), s->scope));
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus storeVariable(VMState *s, int operand) {
+  const IdentifierNode *node = NODE(IdentifierNode, operand);
+  if (wsky_LexicalAddress_isResolved(node->address)) {
+    Value *variable = wsky_Scope_getSlot(s->scope, node->address);
+    if (variable) {
+      *variable = TOP();
+      return VMStatus_CONTINUE;
+    }
+  }
+  CHECK(wsky_eval_assignVariable(node, TOP(), s->scope));
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus pop(VMState *s, int operand) {
+  (void)operand;
+  s->sp--;
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus binaryOperator(VMState *s, int operand) {
+  Value right = POP();
+  CHECK(wsky_eval_binaryOperator(NODE(OperatorNode, operand), TOP(), right));
+  TOP() = s->rv.v;
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus unaryOperator(VMState *s, int operand) {
+  CHECK(wsky_doUnaryOperation((Operator)operand, TOP()));
+  TOP() = s->rv.v;
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus call(VMState *s, int operand) {
+  Value *parameters = s->sp - operand;
+  CHECK(wsky_eval_call(parameters[-1], (unsigned)operand, parameters));
+  s->sp = parameters;
+  TOP() = s->rv.v;
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus callMethod(VMState *s, int operand) {
+  Value *parameters = s->sp - operand;
+  Value callee = parameters[-2];
+  if (wsky_isMethod(callee)) {
+    Method *method = (Method *)Value_getObject(callee);
+    CHECK(wsky_eval_callMethod(method, parameters[-1],
+                               (unsigned)operand, parameters));
+  } else {
+    CHECK(wsky_eval_call(callee, (unsigned)operand, parameters));
+  }
+  s->sp = parameters - 1;
+  TOP() = s->rv.v;
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus tailCall(VMState *s, int operand) {
+  Value *parameters = s->sp - operand;
+  CHECK(wsky_eval_tailCall(parameters[-1], (unsigned)operand, parameters));
+  s->sp = parameters;
+  TOP() = s->rv.v;
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus tailCallMethod(VMState *s, int operand) {
+  Value *parameters = s->sp - operand;
+  Value callee = parameters[-2];
+  if (wsky_isMethod(callee)) {
+    Method *method = (Method *)Value_getObject(callee);
+    CHECK(wsky_eval_tailCallMethod(method, parameters[-1],
+                                   (unsigned)operand, parameters));
+  } else {
+    CHECK(wsky_eval_tailCall(callee, (unsigned)operand, parameters));
+  }
+  s->sp = parameters - 1;
+  TOP() = s->rv.v;
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus getMember(VMState *s, int operand) {
+  CHECK(wsky_eval_getMember(TOP(), MEMBER_NODE(operand), s->scope));
+  TOP() = s->rv.v;
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus getMethod(VMState *s, int operand) {
+  Value object = TOP();
+  Method *method = wsky_eval_findMethod(object, MEMBER_NODE(operand),
+                                        s->scope);
+  if (method) {
+    TOP() = Value_fromObject((Object *)method);
+  } else {
+    CHECK(wsky_eval_getMember(object, MEMBER_NODE(operand), s->scope));
+    TOP() = s->rv.v;
+  }
+  PUSH(object);
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus setMember(VMState *s, int operand) {
+  Value object = POP();
+  CHECK(wsky_eval_setMember(object, MEMBER_NODE(operand), TOP(), s->scope));
+  TOP() = s->rv.v;
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus makeFunction(VMState *s, int operand) {
+  const FunctionNode *node = NODE(FunctionNode, operand);
+  Function *function = wsky_Function_newFromWsky(node->name, node, s->scope);
+  PUSH(Value_fromObject((Object *)function));
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus jump(VMState *s, int operand) {
+  (void)s;
+  (void)operand;
+  return VMStatus_JUMP;
+}
+
+static inline VMStatus jumpIfFalse(VMState *s, int operand) {
+  (void)operand;
+  Value test = POP();
+  if (!wsky_isBoolean(test)) {
+    s->rv = ReturnValue_fromException(
+      (Exception *)wsky_TypeError_new("Expected a boolean"));
+    return VMStatus_ERROR;
+  }
+  return Value_getBool(test) ? VMStatus_CONTINUE : VMStatus_JUMP;
+}
+
+static inline VMStatus enterScopeInstruction(VMState *s, int operand) {
+  s->scope = enterScope(s->scope, NODE(SequenceNode, operand));
+  s->scopeDepth++;
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus leaveScopeInstruction(VMState *s, int operand) {
+  (void)operand;
+  s->scope = leaveScope(s->scope);
+  s->scopeDepth--;
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus enterLoop(VMState *s, int operand) {
+  s->scope = wsky_eval_enterLoop(NODE(LoopNode, operand), s->scope);
+  s->scopeDepth++;
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus nextIteration(VMState *s, int operand) {
+  (void)operand;
+  s->scope = wsky_eval_nextIteration(s->scope);
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus iterate(VMState *s, int operand) {
+  (void)operand;
+  Iterator iterator;
+  CHECK(wsky_Iterator_init(&iterator, TOP()));
+  PUSH(Value_fromInt(iterator.index));
+  return VMStatus_CONTINUE;
+}
+
+/* The iterable and the index of the iterator are on the top */
+static inline VMStatus forNext(VMState *s, int operand) {
+  (void)operand;
+  Iterator iterator = {s->sp[-2], Value_getInt(s->sp[-1])};
+  Value element;
+  bool hasNext = wsky_Iterator_next(&iterator, &element);
+  s->sp[-1] = Value_fromInt(iterator.index);
+  if (hasNext)
+    wsky_Scope_declareSlot(s->scope, 0, element);
+  PUSH(Value_fromBool(hasNext));
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus evalNode(VMState *s, int operand) {
+  CHECK(wsky_evalNode(s->code->nodes[operand], s->scope));
+  PUSH(s->rv.v);
+  return VMStatus_CONTINUE;
+}
+
+static inline VMStatus returnInstruction(VMState *s, int operand) {
+  (void)operand;
+  assert(s->scopeDepth == 0);
+  assert(s->sp == s->stack + 1);
+  s->rv = ReturnValue_fromValue(TOP());
+  return VMStatus_RETURN;
+}
+
+
+/* The instructions which are run the same way by interpret() */
+#define SIMPLE_INSTRUCTIONS(X)                  \
+  X(PUSH_NULL, pushNull)                        \
+  X(PUSH_TRUE, pushTrue)                        \
+  X(PUSH_FALSE, pushFalse)                      \
+  X(PUSH_CONSTANT, pushConstant)                \
+  X(PUSH_STRING, pushString)                    \
+  X(LOAD_VARIABLE, loadVariable)                \
+  X(DECLARE_VARIABLE, declareVariable)          \
+  X(STORE_VARIABLE, storeVariable)              \
+  X(POP, pop)                                   \
+  X(BINARY_OPERATOR, binaryOperator)            \
+  X(UNARY_OPERATOR, unaryOperator)              \
+  X(GET_MEMBER, getMember)                      \
+  X(GET_METHOD, getMethod)                      \
+  X(SET_MEMBER, setMember)                      \
+  X(MAKE_FUNCTION, makeFunction)                \
+  X(JUMP, jump)                                 \
+  X(JUMP_IF_FALSE, jumpIfFalse)                 \
+  X(ENTER_SCOPE, enterScopeInstruction)         \
+  X(LEAVE_SCOPE, leaveScopeInstruction)         \
+  X(ENTER_LOOP, enterLoop)                      \
+  X(NEXT_ITERATION, nextIteration)              \
+  X(ITERATE, iterate)                           \
+  X(FOR_NEXT, forNext)                          \
+  X(EVAL_NODE, evalNode)
+
+#define INSTRUCTIONS(X)                         \
+  SIMPLE_INSTRUCTIONS(X)                        \
+  X(CALL, call)                                 \
+  X(TAIL_CALL, tailCall)                        \
+  X(CALL_METHOD, callMethod)                    \
+  X(TAIL_CALL_METHOD, tailCallMethod)           \
+  X(RETURN, returnInstruction)
+
+const VMInstruction wsky_vm_INSTRUCTIONS[] = {
+#define X(opcode, function) [wsky_Opcode_ ## opcode] = function,
+  INSTRUCTIONS(X)
+#undef X
+};
+
+
+/*
+ * The calls of the functions written in Whiskey made by interpret()
+ * don't use the C stack: the state of the caller is saved in a frame,
+ * and the callee is run by the same loop. This keeps the C stack short,
+ * for the garbage collector which scans it, and allows deep recursions.
+ */
+
+/** A caller waiting for the return of its callee */
+typedef struct {
+  VMState state;
+
+  /** The instruction following the call */
+  const int *ip;
+} Frame;
+
+typedef struct {
+  Frame *frames;
+  unsigned count;
+  unsigned capacity;
+} FrameStack;
+
+
+static Code *getFunctionCode(FunctionNode *node) {
+  if (!node->code)
+    node->code = wsky_compileFunction(node);
+
+  Code *code = node->code;
+  if (wsky_getEngine() == wsky_Engine_JIT && !code->machineCode &&
+      wsky_jit_isEnabled() && code->runCount++ >= wsky_jit_getThreshold())
+    wsky_jit_compile(code);
+  return code;
+}
+
+/*
+ * Returns true if the function is written in Whiskey and can be called
+ * in a frame. The machine code of the JIT compiler can't be run in a
+ * frame.
+ */
+static bool isFrameCallee(Function *function, int parameterCount) {
+  if (!function->node ||
+      !wsky_Function_acceptsParameterCount(function,
+                                           (unsigned)parameterCount))
+    return false;
+  return !getFunctionCode(function->node)->machineCode;
+}
+
+/* Returns the function which can be called in a frame, or NULL */
+static Function *getFrameCallee(Value callee, int parameterCount) {
+  if (!wsky_isFunction(callee))
+    return NULL;
+  Function *function = (Function *)Value_getObject(callee);
+  return isFrameCallee(function, parameterCount) ? function : NULL;
+}
+
+/*
+ * Returns the method pushed by GET_METHOD if it can be called in a
+ * frame, or NULL.
+ */
+static Method *getFrameMethod(Value callee, Value self, int parameterCount) {
+  if (!wsky_isMethod(callee) || wsky_isNull(self) ||
+      Value_getType(self) != Type_OBJECT)
+    return NULL;
+  Method *method = (Method *)Value_getObject(callee);
+  if (wsky_Method_isDefault(method) ||
+      !isFrameCallee(method->function, parameterCount))
+    return NULL;
+  return method;
+}
+
+/*
+ * Makes the function the running code.
+ *
+ * The function is stored below the bottom of the new stack, so that
+ * the garbage collector doesn't delete its code while it runs.
+ */
+static void startFunction(VMState *s, const int **ip, Function *function,
+                          Class *class, Object *self,
+                          const Value *parameters) {
+  Code *code = function->node->code;
+  Value *stack = wsky_stack_allocate(code->maxStackSize + 1);
+  *stack++ = Value_fromObject((Object *)function);
+  Scope *scope = wsky_Function_enterScope(function, class, self,
+                                          parameters);
+  *s = (VMState) {code, scope, stack, stack, 0, ReturnValue_NULL};
+  *ip = code->instructions;
+}
+
+/* Leaves the scopes and the stack of the running function */
+static void stopFunction(VMState *s) {
+  while (s->scopeDepth--)
+    s->scope = leaveScope(s->scope);
+  wsky_Function_leaveScope(s->scope);
+  wsky_stack_release(s->stack - 1);
+}
+
+/* Saves the state of the caller, which waits for the return */
+static void pushFrame(FrameStack *frames, const VMState *s, const int *ip) {
+  if (frames->count == frames->capacity) {
+    frames->capacity = frames->capacity ? frames->capacity * 2 : 16;
+    frames->frames = wsky_realloc(frames->frames,
+                                  frames->capacity * sizeof(Frame));
+    if (!frames->frames)
+      abort();
+  }
+  frames->frames[frames->count++] = (Frame) {*s, ip};
+}
+
+static VMStatus callInFrame(VMState *s, FrameStack *frames,
+                            const int **ip, int operand) {
+  Value *parameters = s->sp - operand;
+  Function *function = getFrameCallee(parameters[-1], operand);
+  if (!function)
+    return call(s, operand);
+
+  /* The callee stays on the stack of the caller until the return */
+  pushFrame(frames, s, *ip);
+  startFunction(s, ip, function, NULL, NULL, parameters);
+  return VMStatus_CONTINUE;
+}
+
+static VMStatus callMethodInFrame(VMState *s, FrameStack *frames,
+                                  const int **ip, int operand) {
+  Value *parameters = s->sp - operand;
+  Method *method = getFrameMethod(parameters[-2], parameters[-1], operand);
+  if (!method)
+    return callMethod(s, operand);
+
+  pushFrame(frames, s, *ip);
+  startFunction(s, ip, method->function, method->defClass,
+                Value_getObject(parameters[-1]), parameters);
+  return VMStatus_CONTINUE;
+}
+
+/*
+ * A tail call replaces the running function. The function called by
+ * the first frame is not replaced, it is running in a
+ * wsky_Function_callSelf() which makes the tail call.
+ */
+static VMStatus tailCallInFrame(VMState *s, FrameStack *frames,
+                                const int **ip, int operand) {
+  if (!frames->count)
+    return tailCall(s, operand);
+
+  Value *parameters = s->sp - operand;
+  Function *function = getFrameCallee(parameters[-1], operand);
+  if (!function || operand > wsky_Function_MAX_TAIL_CALL_PARAMETERS)
+    return call(s, operand);
+
+  /* On the C stack, to be scanned by the garbage collector */
+  Value copy[wsky_Function_MAX_TAIL_CALL_PARAMETERS];
+  memcpy(copy, parameters, sizeof(Value) * (size_t)operand);
+
+  stopFunction(s);
+  startFunction(s, ip, function, NULL, NULL, copy);
+  return VMStatus_CONTINUE;
+}
+
+static VMStatus tailCallMethodInFrame(VMState *s, FrameStack *frames,
+                                      const int **ip, int operand) {
+  if (!frames->count)
+    return tailCallMethod(s, operand);
+
+  Value *parameters = s->sp - operand;
+  Method *method = getFrameMethod(parameters[-2], parameters[-1], operand);
+  if (!method || operand > wsky_Function_MAX_TAIL_CALL_PARAMETERS)
+    return callMethod(s, operand);
+
+  /* On the C stack, to be scanned by the garbage collector */
+  Value copy[wsky_Function_MAX_TAIL_CALL_PARAMETERS];
+  memcpy(copy, parameters, sizeof(Value) * (size_t)operand);
+  Object *self = Value_getObject(parameters[-1]);
+
+  stopFunction(s);
+  startFunction(s, ip, method->function, method->defClass, self, copy);
+  return VMStatus_CONTINUE;
+}
+
+static void returnFromFrame(VMState *s, FrameStack *frames,
+                            const int **ip) {
+  Value result = s->rv.v;
+  stopFunction(s);
+
+  Frame *frame = frames->frames + --frames->count;
+  *s = frame->state;
+  *ip = frame->ip;
+
+  /* The operand of the call, CALL_METHOD also pushed the object */
+  int parameterCount = (*ip)[-1];
+  if ((*ip)[-2] == wsky_Opcode_CALL_METHOD)
+    parameterCount++;
+  s->sp -= parameterCount;
+  TOP() = result;
+}
+
+
+static VMStatus interpret(VMState *s) {
+  FrameStack frames = {NULL, 0, 0};
+  const int *ip = s->code->instructions;
+
+  for (;;) {
+    Opcode opcode = (Opcode)ip[0];
+    int operand = ip[1];
+    ip += 2;
+
+    VMStatus status = VMStatus_CONTINUE;
+    switch (opcode) {
+#define X(opcode, function)                     \
+      case wsky_Opcode_ ## opcode:              \
+        status = function(s, operand);          \
+        break;
+      SIMPLE_INSTRUCTIONS(X)
+#undef X
+
+    case wsky_Opcode_CALL:
+      status = callInFrame(s, &frames, &ip, operand);
+      break;
+
+    case wsky_Opcode_TAIL_CALL:
+      status = tailCallInFrame(s, &frames, &ip, operand);
+      break;
+
+    case wsky_Opcode_CALL_METHOD:
+      status = callMethodInFrame(s, &frames, &ip, operand);
+      break;
+
+    case wsky_Opcode_TAIL_CALL_METHOD:
+      status = tailCallMethodInFrame(s, &frames, &ip, operand);
+      break;
+
+    case wsky_Opcode_RETURN:
+      status = returnInstruction(s, operand);
+      if (frames.count) {
+        returnFromFrame(s, &frames, &ip);
+        status = VMStatus_CONTINUE;
+      }
+      break;
+    }
+
+    switch (status) {
+    case VMStatus_CONTINUE:
+      break;
+
+    case VMStatus_JUMP:
+      ip = s->code->instructions + operand;
+      break;
+
+    case VMStatus_ERROR:
+      /* The exception goes up to the first frame */
+      while (frames.count) {
+        ReturnValue rv = s->rv;
+        stopFunction(s);
+        *s = frames.frames[--frames.count].state;
+        s->rv = rv;
+      }
+      /* Falls through */
+    case VMStatus_RETURN:
+      wsky_free(frames.frames);
+      return status;
+    }
+  }
+}
+
+
+ReturnValue wsky_vm_run(const Code *code, Scope *scope) {
+  Value *stack = wsky_stack_allocate(code->maxStackSize);
+  VMState state = {code, scope, stack, stack, 0, ReturnValue_NULL};
+
+  VMStatus status;
+  if (code->machineCode)
+    status = wsky_jit_run(code, &state);
+  else
+    status = interpret(&state);
+
+  if (status == VMStatus_ERROR) {
+    while (state.scopeDepth--)
+      state.scope = leaveScope(state.scope);
+  }
+  wsky_stack_release(stack);
+  return state.rv;
+}
+
+
+ReturnValue wsky_vm_runFunction(FunctionNode *node, Scope *scope) {
+  return wsky_vm_run(getFunctionCode(node), scope);
+}
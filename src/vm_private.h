@@ -0,0 +1,62 @@
+#ifndef VM_PRIVATE_H
+# define VM_PRIVATE_H
+
+# include "whiskey_private.h"
+
+/**
+ * The state of a running code.
+ *
+ * It is shared by the virtual machine and the machine code of the JIT
+ * compiler, which calls the instructions below.
+ */
+typedef struct {
+  const Code *code;
+
+  /** The current scope */
+  Scope *scope;
+
+  /** The bottom of the operand stack */
+  Value *stack;
+
+  /** The top of the operand stack */
+  Value *sp;
+
+  /** The number of scopes created by ENTER_SCOPE */
+  unsigned scopeDepth;
+
+  /** The returned value or the raised exception */
+  ReturnValue rv;
+} VMState;
+
+
+/** What to do after an instruction */
+typedef enum {
+  /** Go to the next instruction */
+  VMStatus_CONTINUE,
+
+  /** An exception has been raised, it is in `rv` */
+  VMStatus_ERROR,
+
+  /** Go to the instruction given by the operand */
+  VMStatus_JUMP,
+
+  /** The code has returned, the value is in `rv` */
+  VMStatus_RETURN,
+} VMStatus;
+
+
+/** Runs an instruction */
+typedef VMStatus (*VMInstruction)(VMState *state, int operand);
+
+/** The instructions, indexed by their opcode */
+extern const VMInstruction wsky_vm_INSTRUCTIONS[];
+
+
+/**
+ * Runs the machine code of a code compiled with wsky_jit_compile().
+ *
+ * Returns VMStatus_RETURN or VMStatus_ERROR.
+ */
+VMStatus wsky_jit_run(const Code *code, VMState *state);
+
+#endif /* VM_PRIVATE_H */
@@ -3,13 +3,26 @@
 
 static bool started = false;
 
+static wsky_Engine engine = wsky_Engine_AST;
+
 bool wsky_isStarted(void) {
   return started;
 }
 
+wsky_Engine wsky_getEngine(void) {
+  return engine;
+}
+
 void wsky_start(void) {
+  wsky_startWithEngine(wsky_Engine_AST);
+}
+
+void wsky_startWithEngine(wsky_Engine newEngine) {
+  engine = newEngine;
   wsky_GC_init();
   wsky_initBuiltinClasses();
+  wsky_NotImplementedError_initSingleton();
+  wsky_Function_initTailCall();
   wsky_math_init();
   started = true;
 }
@@ -18,7 +31,13 @@ void wsky_start(void) {
 void wsky_stop(void) {
   started = false;
   wsky_GC_deleteAll();
+  wsky_Scope_freeFrameStack();
+  wsky_stack_free();
+  wsky_NotImplementedError_freeSingleton();
+  wsky_Function_freeTailCall();
 
   wsky_freeBuiltinClasses();
   wsky_Module_deleteModules();
+  wsky_selector_free();
+  wsky_Shape_freeAll();
 }
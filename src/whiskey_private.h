@@ -18,31 +18,46 @@
 # define IMPORT(name) typedef wsky_##name name;
 
 IMPORT(AttributeError)
+IMPORT(BuiltinMethodTable)
 IMPORT(Class)
 IMPORT(ClassArray)
+IMPORT(Code)
 IMPORT(ClassDef)
 IMPORT(Dict)
+IMPORT(DynamicField)
 IMPORT(Exception)
 IMPORT(Function)
+IMPORT(GCRoot)
 IMPORT(ImportError)
 IMPORT(InstanceMethod)
+IMPORT(Iterator)
 IMPORT(Keyword)
 IMPORT(LexerResult)
+IMPORT(LexicalAddress)
+IMPORT(MemberName)
 IMPORT(Method)
 IMPORT(MethodDef)
 IMPORT(MethodFlags)
+IMPORT(MethodTable)
+IMPORT(MethodTableEntry)
 IMPORT(Module)
 IMPORT(ModuleList)
 IMPORT(NameError)
 IMPORT(NotImplementedError)
 IMPORT(Object)
-IMPORT(ObjectFields)
+IMPORT(ObjectField)
+IMPORT(OperandTypes)
+IMPORT(Opcode)
 IMPORT(Operator)
+IMPORT(OperatorTable)
 IMPORT(ParameterError)
 IMPORT(ParserResult)
 IMPORT(Position)
 IMPORT(ProgramFile)
 IMPORT(Scope)
+IMPORT(ScopeLayout)
+IMPORT(Shape)
+IMPORT(ShapeCache)
 IMPORT(String)
 IMPORT(StringReader)
 IMPORT(Structure)
@@ -52,6 +67,7 @@ IMPORT(Token)
 IMPORT(TokenList)
 IMPORT(TokenType)
 IMPORT(TypeError)
+IMPORT(TypeFeedback)
 IMPORT(ValueError)
 IMPORT(ZeroDivisionError)
 
@@ -83,6 +99,9 @@ IMPORT(ClassMember)
 IMPORT(Import)
 IMPORT(Export)
 IMPORT(If)
+IMPORT(Loop)
+IMPORT(While)
+IMPORT(For)
 
 #undef IMPORT
 
@@ -19,7 +19,7 @@ static void assertValueEq(const char *expected, Value value,
     return;
   }
   assert(wsky_isString(stringRv.v));
-  wsky_String *string = (wsky_String *) stringRv.v.v.objectValue;
+  wsky_String *string = (wsky_String *) wsky_Value_getObject(stringRv.v);
   yolo_assert_str_eq_impl(expected, string->string, testName, position);
 }
 
@@ -116,6 +116,28 @@ static void strings(void) {
                   "3.0 * 'abc'");
   assertException("ValueError", "The factor cannot be negative",
                   "-3 * 'abc'");
+  assertException("TypeError",
+                  "Unsupported classes for operator *: String and Float",
+                  "String.get('abc', 'operator *')(3.0)");
+  assertEvalEq("abcabc", "String.get('abc', 'operator *')(2)");
+}
+
+/* The operator methods called from C raise a TypeError too */
+static void operatorMethodsFromC(void) {
+  wsky_Object *string = (wsky_Object *)wsky_String_new("abc");
+  Value factor = wsky_Value_fromFloat(3.0);
+  ReturnValue rv = wsky_Object_callMethod(string, "operator *", 1, &factor);
+  yolo_assert_ptr_neq(NULL, rv.exception);
+  if (!rv.exception)
+    return;
+  yolo_assert_str_eq("TypeError", rv.exception->class->name);
+  yolo_assert_str_eq("Unsupported classes for operator *: String and Float",
+                     rv.exception->message);
+
+  factor = wsky_Value_fromInt(2);
+  rv = wsky_Object_callMethod(string, "operator *", 1, &factor);
+  yolo_assert_ptr_eq(NULL, rv.exception);
+  assertReturnValueEq("abcabc", rv, __func__, YOLO__POSITION_STRING);
 }
 
 static void unaryOps(void) {
@@ -171,6 +193,53 @@ static void binaryOps(void) {
   assertEvalEq("-Infinity", "-1 / 0.0");
 }
 
+/* An Integer operation whose result does not fit gives a Float */
+static void integerOverflow(void) {
+#ifdef WSKY_NAN_BOXING
+  /* The integers are 48 bits wide */
+  assertException("SyntaxError", "Too big integer", "140737488355328");
+  assertException("SyntaxError", "Too big integer", "9007199254740993");
+
+  assertEvalEq("140737488355327", "140737488355326 + 1");
+  assertEvalEq("-140737488355327", "-140737488355327");
+  assertEvalEq("1.407374884e+14", "140737488355327 + 1");
+  assertEvalEq("0.0", "140737488355327 + 1 - 140737488355328.0");
+  assertEvalEq("0.0", "-140737488355327 - 2 - -140737488355329.0");
+  assertEvalEq("0.0", "16777216 * 16777216 - 281474976710656.0");
+  assertEvalEq("0.0", "(-140737488355327 - 1) / -1 - 140737488355328.0");
+  assertEvalEq("0.0", "-(-140737488355327 - 1) - 140737488355328.0");
+#else
+  assertEvalEq("9223372036854775807", "9223372036854775806 + 1");
+  assertEvalEq("9.223372037e+18", "9223372036854775807 + 1");
+  assertEvalEq("-9223372036854775808", "-9223372036854775807 - 1");
+  assertEvalEq("-9.223372037e+18", "-9223372036854775807 - 2");
+  assertEvalEq("1.844674407e+19", "4294967296 * 4294967296");
+  assertEvalEq("-1.844674408e+19", "-4294967296 * 4294967297");
+  assertEvalEq("4611686018427387904", "2147483648 * 2147483648");
+  assertEvalEq("9.223372037e+18", "(-9223372036854775807 - 1) / -1");
+  assertEvalEq("9.223372037e+18", "-(-9223372036854775807 - 1)");
+#endif
+}
+
+/* Runs `add` 20 times with the given operands, to specialize `a + b` */
+#define QUICKENED_ADD(a, b)                                             \
+  "var add = {a, b: a + b};"                                            \
+  "var repeat = {n:"                                                    \
+  "    if n == 0: add(" a ", " b ") else: (add(" a ", " b ");"          \
+  "        repeat(n - 1))"                                              \
+  "};"                                                                  \
+  "repeat(20);"
+
+static void quickening(void) {
+  assertEvalEq("3", QUICKENED_ADD("1", "2") "add(1, 2)");
+  assertEvalEq("ab", QUICKENED_ADD("1", "2") "add('a', 'b')");
+  assertEvalEq("1.5", QUICKENED_ADD("1", "2") "add(1, 0.5)");
+  assertEvalEq("3.5", QUICKENED_ADD("'a'", "'b'") "add(1, 2.5)");
+  assertEvalEq("ab", QUICKENED_ADD("'a'", "'b'") "add('a', 'b')");
+  assertEvalEq("a1", QUICKENED_ADD("1.5", "2.0") "add('a', 1)");
+  assertEvalEq("3.5", QUICKENED_ADD("1.5", "2.0") "add(1.5, 2.0)");
+}
+
 static void binaryCmpOps(void) {
   assertEvalEq("false", "567 == 56");
   assertEvalEq("true", "567 == 567");
@@ -196,6 +265,9 @@ static void binaryCmpOps(void) {
   assertException("TypeError",
                   "Unsupported classes for <=: Float and Integer",
                   "0.0 <= 0");
+  assertException("AttributeError",
+                  "'String' object has no method 'operator <'",
+                  "'abc' < 'abd'");
 
   assertEvalEq("false", "566 > 566");
   assertEvalEq("true", "567 > 566");
@@ -283,6 +355,10 @@ static void variable(void) {
   assertException("NameError",
                   "Identifier 'a' already declared",
                   "var a; var a");
+
+  assertEvalEq("<Class String>", "String");
+  assertEvalEq("3", "String = 3; String");
+  assertEvalEq("<Class String>", "String");
 }
 
 static void scope(void) {
@@ -301,6 +377,38 @@ static void scope(void) {
                "        a"
                "    )"
                ")");
+
+  assertEvalEq("3",
+               "var a = 1;"
+               "("
+               "    var b = a;"
+               "    var a = 2;"
+               "    a + b"
+               ")");
+
+  assertEvalEq("2", "var a = 1; (var a = a + 1; a)");
+  assertEvalEq("1", "var a = 1; (if false: (var a = 2) else: a)");
+  assertEvalEq("1", "var a = 1; (if false: var a = 2; a)");
+  assertEvalEq("7", "(var f = {a}; var a = 7; f())");
+  assertEvalEq("5", "(var a = 1; var f = {a = 5}; f(); a)");
+  assertEvalEq("8", "{a, a: a}(1, 8)");
+
+  assertEvalEq("a0a1a2a3",
+               "var f = {n:"
+               "    var s = 'a' + n;"
+               "    (if n == 0: s else: (var t = f(n - 1); t + s))"
+               "};"
+               "f(3)");
+  assertEvalEq("xy",
+               "var f = {a: {b: {a + b}}};"
+               "var g = f('x')('y');"
+               "'z' + 'w';"
+               "g()");
+
+  assertException("NameError", "Use of undeclared identifier 'a'",
+                  "(if false: var a = 2; a)");
+  assertException("NameError", "Identifier 'a' already declared",
+                  "(var a = 1; (var b; var a; var a))");
 }
 
 static void function(void) {
@@ -348,6 +456,13 @@ static void call(void) {
                "};"
                "f(2)(3)");
 
+  assertEvalEq("12",
+               "var f = {a:"
+               "    {b: a + b}"
+               "};"
+               "var g = f(2); var h = f(4);"
+               "g(3) + h(3)");
+
   assertEvalEq("7",
                "{a, b, c: a + b * c}(1, 2, 3)");
 
@@ -360,6 +475,102 @@ static void call(void) {
                   "0()");
 }
 
+/* A block bigger than the next empty chunk replaces it and its followers */
+static void stackChunks(void) {
+  wsky_Value *a = wsky_stack_allocate(8000);
+  wsky_Value *b = wsky_stack_allocate(8000);
+  wsky_Value *c = wsky_stack_allocate(8000);
+  yolo_assert(wsky_isNull(c[7999]));
+  wsky_stack_release(c);
+  wsky_stack_release(b);
+
+  wsky_Value *d = wsky_stack_allocate(20000);
+  d[19999] = wsky_Value_TRUE;
+  yolo_assert(wsky_isBoolean(d[19999]));
+  wsky_stack_release(d);
+  wsky_stack_release(a);
+}
+
+/* More parameters than the 32 of the old buffers of the evaluator */
+static void manyParameters(void) {
+  char source[1024];
+  char *end = source;
+  end += sprintf(end, "var f = {");
+  for (int i = 0; i < 40; i++)
+    end += sprintf(end, i ? ", a%d" : "a%d", i);
+  end += sprintf(end, ": a0 + a20 * a39}; f(");
+  for (int i = 0; i < 40; i++)
+    end += sprintf(end, i ? ", %d" : "%d", i);
+  sprintf(end, ")");
+  assertEvalEq("780", source);
+
+  assertException("ParameterError",
+                  "Invalid parameter count",
+                  "{a: a}(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,"
+                  " 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29,"
+                  " 30, 31, 32, 33, 34)");
+}
+
+static void tailCall(void) {
+  /* Far deeper than the C stack would allow without tail calls */
+  assertEvalEq("100000",
+               "var count = {n, acc:"
+               "  if n == 0: acc else: (var m = n - 1; count(m, acc + 1))};"
+               "count(100000, 0)");
+
+  assertEvalEq("true",
+               "var isEven = {n: if n == 0: true else: isOdd(n - 1)};"
+               "var isOdd = {n: if n == 0: false else: isEven(n - 1)};"
+               "isEven(100000)");
+
+  assertEvalEq("done",
+               "class A ("
+               "  @f {n: if n == 0: 'done' else: @.f(n - 1)}"
+               "); A().f(200000)");
+  assertEvalEq("<B>",
+               "class A (@f {n: if n == 0: @ else: B().g(n - 1)});"
+               "class B (@g {n: if n == 0: @ else: A().f(n - 1)});"
+               "A().f(100001)");
+
+  assertEvalEq("3", "var f = {s: s.indexOf('l')}; f('hello') + 1");
+  assertEvalEq("<Duck>", "class Duck (); var f = {: Duck()}; f()");
+  assertEvalEq("9",
+               "var f = {a: {b: a * b}};"
+               "var g = {a: f(a)(3)}; g(3)");
+
+  assertException("ParameterError",
+                  "Invalid parameter count",
+                  "var f = {a: a}; var g = {: f(1, 2)}; g()");
+
+  assertEvalEq("6",
+               "var sum = {n: if n == 0: 0 else: n + sum(n - 1)};"
+               "sum(3)");
+}
+
+static void deepRecursion(void) {
+  /* Only the bytecode engine runs its calls without recursion */
+  if (wsky_getEngine() != wsky_Engine_BYTECODE)
+    return;
+
+  assertEvalEq("5000050000",
+               "var sum = {n: if n == 0: 0 else: n + sum(n - 1)};"
+               "sum(100000)");
+
+  assertException("ZeroDivisionError", "Division by zero",
+                  "var f = {n: if n == 0: 1 / 0 else: 1 + f(n - 1)};"
+                  "f(100000)");
+
+  assertEvalEq("100001",
+               "var f = {n: if n == 0: 1 else: 1 + f(n - 1)};"
+               "var g = {n: f(n)}; g(100000)");
+
+  assertEvalEq("100000",
+               "class Counter ("
+               "  @count {c, n: if n == 0: 0 else: 1 + c.count(c, n - 1)}"
+               ");"
+               "var c = Counter(); c.count(c, 100000)");
+}
+
 static void functionScope(void) {
   assertEvalEq("2", "var a = 1; {var a = 2; a}()");
   assertEvalEq("1", "var a = 1; {var a = 2}(); a");
@@ -372,9 +583,56 @@ static void method(void) {
 
   assertEvalEq("1", "'hello'.indexOf('e')");
 
+  assertEvalEq("ab <Class String> 1",
+               "var f = {x: x.toString};"
+               "f('ab') + ' ' + f(String) + ' ' + f(1)");
+
   assertException("AttributeError",
                   "'Integer' object has no attribute 'vodka'",
                   "0.vodka");
+
+  assertException("AttributeError",
+                  "'Integer' object has no attribute 'vodka'",
+                  "0.vodka(1 / 0)");
+
+  assertException("TypeError",
+                  "'String' objects are not callable",
+                  "'abc'.toString()");
+
+  assertException("AttributeError",
+                  "'NullClass' object has no attribute 'lol'",
+                  "null.lol()");
+
+  assertException("TypeError",
+                  "'NullClass' objects are not callable",
+                  "null()");
+
+  assertEvalEq("5",
+               "class Duck ("
+               "  init {@f = {x: x + 1}};"
+               "  get @f"
+               ");"
+               "Duck().f(4)");
+
+  assertEvalEq("6",
+               "class Duck ("
+               "  @f {x: x + 1};"
+               "  @g {var f = @f; f(4) + 1}"
+               ");"
+               "Duck().g()");
+
+  assertEvalEq("3",
+               "class Duck ("
+               "  @count {d, n: if n == 0: 0 else: 1 + d.count(d, n - 1)}"
+               ");"
+               "var d = Duck(); d.count(d, 3)");
+
+  assertEvalEq("123",
+               "class Duck ("
+               "  private @lol {123};"
+               "  @callLol {d: d.lol()}"
+               ");"
+               "var d = Duck(); d.callLol(d)");
 }
 
 static void toString(void) {
@@ -432,6 +690,27 @@ static void string(void) {
   assertEvalEq("false", "'' != ''");
   assertEvalEq("false", "'abc' != 'abc'");
   assertEvalEq("true", "'abc' != 'abd'");
+
+  assertEvalEq("abcabcabc", "var f = {: 'abc'}; var a = f(); f() + a + f()");
+}
+
+static void stringLiteral(void) {
+  wsky_ParserResult pr = wsky_parseString("'abc'");
+  yolo_assert(pr.success);
+  wsky_SequenceNode *program = (wsky_SequenceNode *)pr.node;
+  const wsky_LiteralNode *node;
+  node = (const wsky_LiteralNode *)program->children->node;
+
+  wsky_String *string = wsky_LiteralNode_getString(node);
+  yolo_assert_str_eq("abc", string->string);
+  yolo_assert_ptr_eq(string, wsky_LiteralNode_getString(node));
+
+  /* The node keeps the String alive */
+  wsky_GC_autoCollect();
+  yolo_assert_str_eq("abc", string->string);
+  yolo_assert_ptr_eq(string, wsky_LiteralNode_getString(node));
+
+  wsky_ASTNode_delete(pr.node);
 }
 
 static void class(void) {
@@ -599,6 +878,21 @@ static void classSetter(void) {
                   "d.a = 'a';"
                   );
 
+  /* The same assignment on the objects of different classes */
+  assertEvalEq("1 2",
+               "class A (set @x {v: @y = v}; get @y);"
+               "class B: A (set @x {v: @y = v + 1}; get @y);"
+               "var f = {o, v: o.x = v};"
+               "var a = A(); var b = B(); f(a, 1); f(b, 1);"
+               "a.y.toString + ' ' + b.y.toString");
+
+  assertException("AttributeError",
+                  "'B' object has no attribute 'x'",
+                  "class A (set @x {v: @y = v});"
+                  "class B (get @x {0});"
+                  "var f = {o: o.x = 1};"
+                  "f(A()); f(B())");
+
   assertException("AttributeError",
                   "'Duck' object has no attribute 'a'",
                   "class Duck ("
@@ -860,6 +1154,199 @@ static void ctorInheritance(void) {
                "b.a");
 }
 
+/* The methods are inherited through the vtables */
+static void deepInheritance(void) {
+  assertEvalEq("b b c",
+               "class A (@f {'a'}; @g {'a'}; @h {'a'});"
+               "class B: A (@f {'b'}; @g {'b'});"
+               "class C: B (@g {'c'});"
+               "class D: C ();"
+               "var d = D();"
+               "d.f() + ' ' + B().g() + ' ' + d.g()");
+
+  assertEvalEq("2",
+               "class A (get @x {1}; set @x {v: @y = v}; get @y);"
+               "class B: A ();"
+               "class C: B (get @x {2});"
+               "var c = C();"
+               "c.x = 3;"
+               "c.x");
+
+  assertEvalEq("1",
+               "class A (get @x {1});"
+               "class B: A (); class C: B (); class D: C ();"
+               "A.get(D(), 'x')");
+
+  assertException("TypeError",
+                  "Expected a 'C', got a 'B'",
+                  "class A (get @x {1});"
+                  "class B: A (); class C: A ();"
+                  "C.get(B(), 'x')");
+}
+
+static void structures(void) {
+  assertEvalEq("3", "var s = Structure(); s.a = 1; s.a = 3; s.a");
+
+  /* The same member is in different slots */
+  assertEvalEq("1 2 3",
+               "var f = {s: s.a.toString};"
+               "var s = Structure(); s.a = 1;"
+               "var t = Structure(); t.b = 0; t.a = 2;"
+               "var u = Structure(); u.a = 3; u.b = 0;"
+               "f(s) + ' ' + f(t) + ' ' + f(u)");
+
+  assertEvalEq("15",
+               "var s = Structure();"
+               "s.a = 1; s.b = 2; s.c = 3; s.d = 4; s.e = 5;"
+               "s.a + s.b + s.c + s.d + s.e");
+
+  assertException("AttributeError",
+                  "'Structure' object has no attribute 'b'",
+                  "var f = {s: s.b};"
+                  "var s = Structure(); s.b = 1; f(s);"
+                  "var t = Structure(); t.a = 1; f(t)");
+
+  /* The stores remember their slot, or the shape they add */
+  assertEvalEq("7",
+               "var f = {s, v: s.a = v};"
+               "var s = Structure(); f(s, 1);"
+               "var t = Structure(); f(t, 2);"
+               "var u = Structure(); u.b = 0; f(u, 3); f(u, 4);"
+               "s.a + t.a + u.a + u.b");
+
+  assertEvalEq("12",
+               "var f = {s:"
+               "  s.a = 1; s.b = 2; s.c = 3; s.d = 4; s.e = 5; s.f = 6; s"
+               "};"
+               "f(Structure()); var s = f(Structure()); f(s);"
+               "s.a + s.e + s.f");
+}
+
+/* The tables of a class depend on its methods, not on the selectors */
+static void methodTables(void) {
+  char name[32];
+  for (int i = 0; i < 4000; i++) {
+    sprintf(name, "methodTables%d", i);
+    wsky_selector_intern(name);
+  }
+
+  ReturnValue rv = wsky_evalString("class A (@f {1}); class B: A (@g {2})");
+  yolo_assert_ptr_eq(NULL, rv.exception);
+  const wsky_Class *class = (const wsky_Class *)wsky_Value_getObject(rv.v);
+  yolo_assert(class->vtable.count < 200);
+  yolo_assert(class->vtable.mask < 4 * class->vtable.count);
+
+  assertEvalEq("3", "class A (@f {1}); class B: A (@g {2});"
+               "var b = B(); b.f() + b.g()");
+}
+
+/* The builtin classes have static tables, indexed by builtin selector */
+static void builtinMethodTables(void) {
+  yolo_assert_int_eq(wsky_Selector_LENGTH, wsky_selector_find("length"));
+  yolo_assert_int_eq(wsky_Selector_R_PLUS,
+                     wsky_selector_find("operator r+"));
+
+  wsky_Class *string = wsky_String_CLASS;
+  yolo_assert_ptr_eq(NULL, string->vtable.entries);
+  yolo_assert_ptr_eq(wsky_Class_findMethodOrGetter(string, "indexOf"),
+                     string->builtinTable->methods[wsky_Selector_INDEX_OF]);
+
+  /* Inherited from Object */
+  yolo_assert_ptr_eq(wsky_Class_findMethodOrGetter(wsky_Object_CLASS,
+                                                   "class"),
+                     wsky_Class_findMethodBySelector(string,
+                                                     wsky_Selector_CLASS));
+
+  unsigned selector = wsky_selector_intern("builtinMethodTables");
+  yolo_assert_ptr_eq(NULL, wsky_Class_findMethodBySelector(string, selector));
+
+  assertEvalEq("3 1 abab", "var s = 'abc'; s.length + ' ' + s.indexOf('b') +"
+               "' ' + 'ab' * 2");
+}
+
+/* Returns the number of names hashed by the evaluation of a program */
+static unsigned long countNameLookups(const char *source,
+                                      const char *expected,
+                                      const char *testName,
+                                      const char *position) {
+  unsigned long count = wsky_selector_getFindCount();
+  assertEvalEqImpl(expected, source, testName, position);
+  return wsky_selector_getFindCount() - count;
+}
+
+/* The accessors of the fields do not look up the names */
+static void fieldLookups(void) {
+  const char *format =
+    "class A ("
+    "  init {@x = 1};"
+    "  get @x;"
+    "  @sum {n: var s = 0; for i in n: s = s + @x; s}"
+    ");"
+    "var a = A(); var s = a.sum(%d);"
+    "for i in %d: s = s + a.x;"
+    "s";
+
+  char source[256];
+  sprintf(source, format, 1, 1);
+  unsigned long once = countNameLookups(source, "2",
+                                        __func__, YOLO__POSITION_STRING);
+  sprintf(source, format, 100, 100);
+  unsigned long hundredTimes = countNameLookups(source, "200", __func__,
+                                                YOLO__POSITION_STRING);
+  yolo_assert_ulong_eq(once, hundredTimes);
+}
+
+static void privateFields(void) {
+  /* The default accessors use the field of their class */
+  assertEvalEq("1 2 3",
+               "class A (init {@x = 1}; get @x);"
+               "class B: A (init {super(); @y = 2}; get @y);"
+               "class C: B (init {super(); @z = 3}; get @z);"
+               "var c = C();"
+               "c.x.toString + ' ' + c.y.toString + ' ' + c.z.toString");
+
+  assertEvalEq("5",
+               "class A (get @x; set @x);"
+               "class B: A ();"
+               "var b = B(); b.x = 5; b.x");
+
+  assertException("AttributeError",
+                  "'B' object has no attribute 'x'",
+                  "class A (get @x);"
+                  "class B: A ();"
+                  "B().x");
+
+  /* Each class has its own fields */
+  assertEvalEq("1 2",
+               "class A ("
+               "  init {@x = 1};"
+               "  @getA {@x}"
+               ");"
+               "class B: A ("
+               "  init {super(); @x = 2};"
+               "  @getB {@x}"
+               ");"
+               "var b = B();"
+               "b.getA().toString + ' ' + b.getB().toString");
+
+  assertEvalEq("3",
+               "class C ("
+               "  @set {c, v: c.y = v};"
+               "  @get {c: c.y}"
+               ");"
+               "var c = C();"
+               "c.set(c, 3);"
+               "c.get(c)");
+
+  assertException("AttributeError",
+                  "'C' object has no attribute 'y'",
+                  "class C ("
+                  "  @get {: @y};"
+                  "  @set {: @y = 1}"
+                  ");"
+                  "C().get()");
+}
+
 
 static void ifElse(void) {
   assertEvalEq("1", "if true: 1");
@@ -872,6 +1359,42 @@ static void ifElse(void) {
 }
 
 
+static void loops(void) {
+  assertEvalEq("null", "while false: 1");
+  assertEvalEq("10", "var i = 0; while i < 10: i = i + 1; i");
+  assertEvalEq("45",
+               "var i = 0; var s = 0;"
+               "while i < 10: (var j = i; s = s + j; i = i + 1); s");
+  assertEvalEq("0123", "var s = ''; for i in 4: s = s + i; s");
+  assertEvalEq("", "var s = ''; for i in -2: s = s + i; s");
+  assertEvalEq("c.b.a.",
+               "var s = ''; for c in 'abc': (var d = c + '.'; s = d + s); s");
+  assertEvalEq("2",
+               "var n = 0; for c in 'abab': (if c == 'b': n = n + 1); n");
+  assertEvalEq("6",
+               "var s = 0;"
+               "for i in 3: for j in 3: (var k = i * j; s = s + k); s - 3");
+
+  /* Each iteration has its own variables for the functions it creates */
+  assertEvalEq("20",
+               "var f = null;"
+               "for i in 4: (var j = i * 10; if i == 2: f = {j}); f()");
+  assertEvalEq("1",
+               "var f = null; for i in 3: (if i == 1: f = {i}); f()");
+
+  assertEvalEq("3",
+               "var f = {n: (var s = 0; for i in n: s = s + 1; s)}; f(3)");
+
+  assertException("TypeError", "Expected a boolean", "while 1: 2");
+  assertException("TypeError", "'Float' objects are not iterable",
+                  "for i in 1.5: i");
+  assertException("NameError", "Use of undeclared identifier 'i'",
+                  "for i in 2: 1; i");
+  assertException("ZeroDivisionError", "Division by zero",
+                  "var i = 0; while i < 3: (i = i + 1; 1 / 0)");
+}
+
+
 static void helloScript(void) {
   char *filePath = getLocalFilePath("hello.wsky");
   assertReturnValueEq("Hello, World!", wsky_evalFile(filePath),
@@ -894,6 +1417,30 @@ static void module(void) {
 }
 
 
+/* Evaluates a program with the AST engine, without resolving it */
+static ReturnValue evalUnresolved(const char *source) {
+  wsky_ParserResult pr = wsky_parseString(source);
+  assert(pr.success);
+  wsky_Scope *scope = wsky_Scope_newRoot(wsky_Module_newMain());
+  wsky_eval_pushScope(scope);
+  ReturnValue rv = wsky_evalNode(pr.node, scope);
+  wsky_eval_popScope();
+  wsky_ASTNode_delete(pr.node);
+  return rv;
+}
+
+static void unresolvedClass(void) {
+  /* The fields of a class which is not resolved are not in its layout */
+  assertReturnValueEq("3",
+                      evalUnresolved("class A (init {@x = 3}; get @x);"
+                                     "A().x"),
+                      __func__, YOLO__POSITION_STRING);
+  assertReturnValueEq("5",
+                      evalUnresolved("class A (get @x; set @x);"
+                                     "var a = A(); a.x = 5; a.x"),
+                      __func__, YOLO__POSITION_STRING);
+}
+
 void evalTestSuite(void) {
   syntaxError();
 
@@ -901,10 +1448,13 @@ void evalTestSuite(void) {
 
   literals();
   strings();
+  operatorMethodsFromC();
 
   unaryOps();
   binaryOps();
+  integerOverflow();
   binaryCmpOps();
+  quickening();
   binaryBoolOps();
   sequence();
   var();
@@ -912,12 +1462,17 @@ void evalTestSuite(void) {
   scope();
   function();
   call();
+  manyParameters();
+  stackChunks();
+  tailCall();
+  deepRecursion();
   functionScope();
   method();
   toString();
   getClass();
   objectEquals();
   string();
+  stringLiteral();
   class();
   classGetter();
   classSetter();
@@ -928,7 +1483,15 @@ void evalTestSuite(void) {
   builtinClasses();
   inheritance();
   ctorInheritance();
+  deepInheritance();
+  methodTables();
+  builtinMethodTables();
+  privateFields();
+  unresolvedClass();
+  fieldLookups();
+  structures();
   ifElse();
+  loops();
   helloScript();
   module();
 }
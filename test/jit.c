@@ -0,0 +1,113 @@
+#include "test.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "whiskey.h"
+
+typedef wsky_ReturnValue ReturnValue;
+
+
+/** The programs run by both engines, which must give the same results */
+static const char *const PROGRAMS[] = {
+  "var f = {a, b: a + b - 3}; f(4, 5)",
+  "var f = {a, b: a + b}; f(1.5, 2)",
+  "var f = {a, b: a - b * 2.5}; f(1.5, 2.0)",
+  "var f = {a, b: (a < b).toString + (a <= b).toString + (a > b).toString"
+  "  + (a >= b).toString};"
+  "f(1, 2) + f(2, 2) + f(3, 2)",
+  "var f = {a, b: (a < b).toString + (a > b).toString};"
+  "f(1.0, 2) + f(-1, -1.0) + f(1.5, 2.5) + f(-1.0, -1.0)",
+  "var f = {a, b: (a == b).toString + (a != b).toString};"
+  "f(1, 2) + f(2, 2) + f(3, 2)",
+  "var f = {a, b: a == b}; f(1.0, 2)",
+  "var f = {a, b: a + b}; f('a', 'b') + f(1, 'b') + f('a', 2)",
+  "var f = {n: if n < 0: 'negative' else if n == 0: 'zero' else: n};"
+  "f(-1) + f(0) + f(1)",
+  "var f = {n: if n < 0: 'negative' else: n}; f(2.5)",
+  "var fib = {n: if n < 2: n else: fib(n - 1) + fib(n - 2)}; fib(15)",
+  "var sum = {n: (var s = 0; var i = 0;"
+  "  var loop = {: if i <= n: (s = s + i; i = i + 1; loop())};"
+  "  loop(); s)};"
+  "sum(30)",
+  "var counter = {: (var n = 0; {: n = n + 1})};"
+  "var c = counter(); c(); c(); c()",
+  "var f = {x: (var a = x; (var b = a + 1; var c = b * 2; c) + a)}; f(3)",
+  "var f = {x: if x: 1 else: 2}; f(1)",
+  "var f = {x: x.length}; f('abc') + f('')",
+  "var f = {x: undefined + x}; f(1)",
+  "var f = {x: 9223372036854775807 + x}; f(1)",
+  "var f = {x: -9223372036854775807 - x}; f(2)",
+  "var f = {x: -x}; f(1).toString + f(-2.5).toString",
+  "var f = {: (var a); a}; f()",
+};
+
+#define PROGRAM_COUNT (sizeof(PROGRAMS) / sizeof(PROGRAMS[0]))
+
+/** The number of runs of each program, to make its functions hot */
+#define RUN_COUNT 3
+
+
+static char *run(const char *source) {
+  ReturnValue rv = wsky_evalString(source);
+  if (rv.exception) {
+    const char *className = rv.exception->class->name;
+    const char *message = rv.exception->message;
+    char *result = wsky_safeMalloc(strlen(className) + strlen(message) + 3);
+    sprintf(result, "%s: %s", className, message);
+    return result;
+  }
+  rv = wsky_toString(rv.v);
+  yolo_assert_ptr_eq(NULL, rv.exception);
+  if (rv.exception)
+    return wsky_strdup("");
+  return wsky_strdup(((wsky_String *)wsky_Value_getObject(rv.v))->string);
+}
+
+
+static void compareWithAst(void) {
+  char *expected[PROGRAM_COUNT];
+
+  wsky_start();
+  for (size_t i = 0; i < PROGRAM_COUNT; i++)
+    expected[i] = run(PROGRAMS[i]);
+  wsky_stop();
+
+  unsigned previousThreshold = wsky_jit_getThreshold();
+  wsky_jit_setThreshold(0);
+  wsky_startWithEngine(wsky_Engine_JIT);
+  for (size_t i = 0; i < PROGRAM_COUNT; i++) {
+    for (unsigned j = 0; j < RUN_COUNT; j++) {
+      char *result = run(PROGRAMS[i]);
+      yolo_assert_str_eq(expected[i], result);
+      wsky_free(result);
+    }
+    wsky_free(expected[i]);
+  }
+  wsky_stop();
+  wsky_jit_setThreshold(previousThreshold);
+}
+
+static void killSwitch(void) {
+  bool enabled = wsky_jit_isEnabled();
+
+  wsky_jit_setEnabled(false);
+  yolo_assert(!wsky_jit_isEnabled());
+  wsky_Code *code = wsky_Code_new();
+  wsky_Code_addInstruction(code, wsky_Opcode_PUSH_NULL, 0);
+  wsky_Code_addInstruction(code, wsky_Opcode_RETURN, 0);
+  yolo_assert(!wsky_jit_compile(code));
+  yolo_assert_ptr_eq(NULL, code->machineCode);
+
+  wsky_jit_setEnabled(enabled);
+  if (wsky_jit_isEnabled()) {
+    yolo_assert(wsky_jit_compile(code));
+    yolo_assert_ptr_neq(NULL, code->machineCode);
+  }
+  wsky_Code_delete(code);
+}
+
+
+void jitTestSuite(void) {
+  compareWithAst();
+  killSwitch();
+}
@@ -0,0 +1,93 @@
+#include "test.h"
+
+#include "whiskey.h"
+
+
+# define assertOptimizedEq(expectedAstString, source)                   \
+  assertOptimizedEqImpl((expectedAstString), (source),                  \
+                        __func__, YOLO__POSITION_STRING)
+
+
+static void assertOptimizedEqImpl(const char *expectedAstString,
+                                  const char *source,
+                                  const char *testName,
+                                  const char *position) {
+
+  wsky_ParserResult pr = wsky_parseString(source);
+  if (!pr.success) {
+    yolo_fail_impl(testName, position);
+    wsky_SyntaxError_print(&pr.syntaxError, stdout);
+    wsky_SyntaxError_free(&pr.syntaxError);
+    printf("\n");
+    return;
+  }
+
+  wsky_ASTNode *node = wsky_optimize(pr.node);
+  char *astString = wsky_ASTNode_toString(node);
+  yolo_assert_str_eq_impl(expectedAstString, astString, testName, position);
+  wsky_free(astString);
+  wsky_ASTNode_delete(node);
+}
+
+
+static void folding(void) {
+  assertOptimizedEq("3", "1 + 2");
+  assertOptimizedEq("-7", "-(3 + 4)");
+  assertOptimizedEq("7.5", "2.5 * 3");
+  assertOptimizedEq("true", "1 < 2");
+  assertOptimizedEq("false", "not (1.5 < 2.0)");
+  assertOptimizedEq("true", "true and (false or true)");
+  assertOptimizedEq("'ab'", "'a' + 'b'");
+  assertOptimizedEq("'a1'", "'a' + 1");
+  assertOptimizedEq("(a + 3)", "a + (1 + 2)");
+  assertOptimizedEq("((1 + a) + 2)", "1 + a + 2");
+  assertOptimizedEq("var a = 6", "var a = 2 * 3");
+  assertOptimizedEq("f(3, 'ab')", "f(1 + 2, 'a' + 'b')");
+  assertOptimizedEq("{x: (x * 4)}", "{x: x * (2 + 2)}");
+}
+
+static void noFolding(void) {
+  assertOptimizedEq("(1 / 0)", "1 / 0");
+  assertOptimizedEq("(1 + null)", "1 + null");
+  assertOptimizedEq("(1 == 1.0)", "1 == 1.0");
+  assertOptimizedEq("('a' - 1)", "'a' - 1");
+}
+
+static void deadBranches(void) {
+  assertOptimizedEq("1", "if true: 1 else: 2");
+  assertOptimizedEq("2", "if false: 1 else: 2");
+  assertOptimizedEq("null", "if false: 1");
+  assertOptimizedEq("3", "if 1 > 2: 1 else if 2 > 1: 3 else: 2");
+  assertOptimizedEq("if a: 1 else: 3",
+                    "if a: 1 else if false: 2 else if true: 3 else: 4");
+  assertOptimizedEq("if a: 1", "if false: 0 else if a: 1");
+  assertOptimizedEq("if 1: 2", "if 1: 2");
+  assertOptimizedEq("null", "while false: a");
+  assertOptimizedEq("while a: 3", "while a: 1 + 2");
+  assertOptimizedEq("for a in 3: b", "for a in 1 + 2: b");
+}
+
+static void disabled(void) {
+  bool enabled = wsky_optimizer_isEnabled();
+  wsky_optimizer_setEnabled(false);
+  assertOptimizedEq("(1 + 2)", "1 + 2");
+  assertOptimizedEq("if true: 1", "if true: 1");
+  wsky_optimizer_setEnabled(enabled);
+}
+
+static void evaluation(void) {
+  assertEvalEq("3", "1 + 2");
+  assertEvalEq("1", "var a = 1; (if false: var a = 2; a)");
+  assertEvalEq("2", "var a = 1; (if true: var a = 2; a)");
+  assertException("ZeroDivisionError", "Division by zero", "1 / 0");
+  assertException("TypeError", "Expected a boolean", "if 1: 2");
+}
+
+
+void optimizerTestSuite(void) {
+  folding();
+  noFolding();
+  deadBranches();
+  disabled();
+  evaluation();
+}
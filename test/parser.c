@@ -341,6 +341,23 @@ static void ifElse(void) {
               "if a: b else if c: d else if e: f");
 }
 
+static void loops(void) {
+  assertSyntaxError("Expected condition", "while");
+  assertSyntaxError("Expected colon", "while a");
+  assertSyntaxError("Expected expression", "while a:");
+  assertSyntaxError("Expected variable name", "for");
+  assertSyntaxError("Expected 'in'", "for a");
+  assertSyntaxError("Expected expression", "for a in");
+  assertSyntaxError("Expected colon", "for a in b");
+  assertSyntaxError("Expected expression", "for a in b:");
+
+  assertAstEq("while a: b", "while a: b");
+  assertAstEq("while (a < 3): ((a = (a + 1)))", "while a < 3: (a = a + 1)");
+  assertAstEq("for a in b: c", "for a in b: c");
+  assertAstEq("for a in b.c: (var d = a; e(d))",
+              "for a in b.c: (var d = a; e(d))");
+}
+
 void parserTestSuite(void) {
   expression();
   literals();
@@ -357,4 +374,5 @@ void parserTestSuite(void) {
   method();
   super();
   ifElse();
+  loops();
 }
@@ -11,7 +11,7 @@ static void baseTests(void) {
   ReturnValue rv = wsky_ProgramFile_new(filePath);
   wsky_free(filePath);
   yolo_assert_null(rv.exception);
-  ProgramFile *pf = (ProgramFile *)rv.v.v.objectValue;
+  ProgramFile *pf = (ProgramFile *)wsky_Value_getObject(rv.v);
   yolo_assert_not_null(pf);
   yolo_assert_ulong_neq(0, strlen(pf->content));
   yolo_assert_str_eq("eval.c", pf->name);
@@ -27,6 +27,7 @@ int main() {
   wsky_start();
 
   dictTestSuite();
+  valueTestSuite();
   exceptionTestSuite();
   programFileTestSuite();
   positionTestSuite();
@@ -35,10 +36,36 @@ int main() {
   parserTestSuite();
   evalTestSuite();
   mathTestSuite();
+  optimizerTestSuite();
 
   runWhiskeyTests();
 
   wsky_stop();
+
+  /* The same tests with the virtual machine */
+  wsky_startWithEngine(wsky_Engine_BYTECODE);
+
+  evalTestSuite();
+  mathTestSuite();
+
+  runWhiskeyTests();
+
+  wsky_stop();
+
+  /* The same tests with the JIT compiler, which compiles every function */
+  wsky_jit_setThreshold(0);
+  wsky_startWithEngine(wsky_Engine_JIT);
+
+  evalTestSuite();
+  mathTestSuite();
+
+  runWhiskeyTests();
+
+  wsky_stop();
+  wsky_jit_setThreshold(wsky_jit_DEFAULT_THRESHOLD);
+
+  jitTestSuite();
+
   yolo_end();
 
   return 0;
@@ -35,5 +35,8 @@ void lexerTestSuite(void);
 void parserTestSuite(void);
 void evalTestSuite(void);
 void mathTestSuite(void);
+void jitTestSuite(void);
+void optimizerTestSuite(void);
+void valueTestSuite(void);
 
 #endif /* TEST_H */
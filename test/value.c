@@ -0,0 +1,70 @@
+#include "test.h"
+
+#include <math.h>
+#include "whiskey.h"
+
+typedef wsky_Value Value;
+
+
+static void integers(void) {
+  const wsky_int ints[] = {
+    0, 1, -1, 42, -123456789, wsky_Value_INT_MIN, wsky_Value_INT_MAX
+  };
+  for (size_t i = 0; i < sizeof(ints) / sizeof(ints[0]); i++) {
+    Value v = wsky_Value_fromInt(ints[i]);
+    yolo_assert(wsky_isInteger(v));
+    yolo_assert_long_eq(ints[i], wsky_Value_getInt(v));
+  }
+
+#ifdef WSKY_NAN_BOXING
+  /* The integers which don't fit wrap around */
+  Value v = wsky_Value_fromInt(wsky_Value_INT_MAX + 1);
+  yolo_assert_long_eq(wsky_Value_INT_MIN, wsky_Value_getInt(v));
+  v = wsky_Value_fromInt(wsky_Value_INT_MIN - 1);
+  yolo_assert_long_eq(wsky_Value_INT_MAX, wsky_Value_getInt(v));
+#endif
+}
+
+static void floats(void) {
+  const wsky_float floats[] = {0.0, -0.0, 1.5, -2.25, 1e300, INFINITY};
+  for (size_t i = 0; i < sizeof(floats) / sizeof(floats[0]); i++) {
+    Value v = wsky_Value_fromFloat(floats[i]);
+    yolo_assert(wsky_isFloat(v));
+    yolo_assert(floats[i] == wsky_Value_getFloat(v));
+  }
+
+  Value v = wsky_Value_fromFloat(-INFINITY);
+  yolo_assert(wsky_isFloat(v));
+  yolo_assert(wsky_Value_getFloat(v) < 0);
+
+  v = wsky_Value_fromFloat(NAN);
+  yolo_assert(wsky_isFloat(v));
+  yolo_assert(isnan(wsky_Value_getFloat(v)));
+
+  v = wsky_Value_fromFloat(-NAN);
+  yolo_assert(wsky_isFloat(v));
+  yolo_assert(isnan(wsky_Value_getFloat(v)));
+}
+
+static void booleansAndObjects(void) {
+  yolo_assert(wsky_isBoolean(wsky_Value_TRUE));
+  yolo_assert(wsky_Value_getBool(wsky_Value_fromBool(true)));
+  yolo_assert(!wsky_Value_getBool(wsky_Value_fromBool(false)));
+  yolo_assert(!wsky_isNull(wsky_Value_FALSE));
+
+  yolo_assert(wsky_isNull(wsky_Value_NULL));
+  yolo_assert(wsky_isNull(wsky_Value_fromObject(NULL)));
+  yolo_assert_int_eq(wsky_Type_OBJECT, wsky_Value_getType(wsky_Value_NULL));
+
+  wsky_String *string = wsky_String_new("abc");
+  Value v = wsky_Value_fromObject((wsky_Object *)string);
+  yolo_assert(wsky_isString(v));
+  yolo_assert_ptr_eq(string, wsky_Value_getObject(v));
+}
+
+
+void valueTestSuite(void) {
+  integers();
+  floats();
+  booleansAndObjects();
+}